@@ -0,0 +1,71 @@
+#ifndef CS_BARRIER_HPP
+#define CS_BARRIER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <functional>
+
+#include <cs/utils/details/futex.hpp>
+
+namespace cs {
+// reusable rendezvous of fixed threads count, every phase ends when all threads arrived,
+// last arriving thread calls completion and opens next phase, others sleep at futex meanwhile
+class Barrier {
+public:
+    explicit Barrier(uint32_t count, std::function<void()> completion = {}):
+        expected_(count), completion_(std::move(completion)) {}
+
+    Barrier(const Barrier&) = delete;
+    Barrier& operator=(const Barrier&) = delete;
+
+    // blocks until all threads arrive at current phase, returns phase number which was finished
+    uint32_t arriveAndWait() {
+        const uint32_t phase = phase_.load(std::memory_order_acquire);
+
+        if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == expected_) {
+            arrived_.store(0, std::memory_order_relaxed);
+
+            if (completion_) {
+                completion_();
+            }
+
+            phase_.fetch_add(1, std::memory_order_seq_cst);
+
+            if (waiters_.load(std::memory_order_seq_cst) != 0) {
+                details::futexWake(phase_, details::futexWakeAll);
+            }
+
+            return phase;
+        }
+
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+
+        while (phase_.load(std::memory_order_seq_cst) == phase) {
+            details::futexWait(phase_, phase);
+        }
+
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return phase;
+    }
+
+    // returns number of current phase
+    uint32_t phase() const noexcept {
+        return phase_.load(std::memory_order_acquire);
+    }
+
+    uint32_t count() const noexcept {
+        return expected_;
+    }
+
+private:
+    const uint32_t expected_;
+    std::function<void()> completion_;
+
+    std::atomic<uint32_t> arrived_ = { 0 };
+    details::FutexWord phase_ = { 0 };
+    std::atomic<uint32_t> waiters_ = { 0 };
+};
+}
+
+#endif // CS_BARRIER_HPP
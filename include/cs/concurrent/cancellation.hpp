@@ -0,0 +1,152 @@
+#ifndef CS_CANCELLATION_HPP
+#define CS_CANCELLATION_HPP
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <exception>
+
+#include <cs/concurrent/task.hpp>
+
+namespace cs {
+// thrown by CancellationToken::throwIfCancelled, Concurrent reports task stopped by it as cancelled
+class CancelledException : public std::exception {
+public:
+    virtual const char* what() const noexcept override {
+        return "Operation cancelled";
+    }
+};
+
+namespace details {
+// shared flag of source and its tokens, callbacks are called once by cancelling thread,
+// callbacks are kept by id in adding order, so they could be removed before cancellation
+struct CancellationState {
+    std::atomic<bool> cancelled = { false };
+
+    std::mutex mutex;
+    std::map<uint64_t, Task> callbacks;
+    uint64_t nextId = 1;
+};
+}
+
+// read side of cancellation, cheap to copy and poll,
+// default token is never cancelled
+class CancellationToken {
+public:
+    // id of added callback, zero means callback was not added
+    using CallbackId = uint64_t;
+
+    CancellationToken() = default;
+
+    bool isCancelled() const noexcept {
+        return state_ && state_->cancelled.load(std::memory_order_acquire);
+    }
+
+    // returns false for default token
+    bool canBeCancelled() const noexcept {
+        return static_cast<bool>(state_);
+    }
+
+    // lets running task stop by exception
+    void throwIfCancelled() const {
+        if (isCancelled()) {
+            throw CancelledException();
+        }
+    }
+
+    // func is called once by cancelling thread, or at once if token is cancelled already,
+    // func is never called for default token, returns id for removeCallback,
+    // callback is kept by source until cancellation or removal
+    template <typename Func>
+    CallbackId onCancelled(Func&& func) const {
+        if (!state_) {
+            return 0;
+        }
+
+        Task callback(std::forward<Func>(func));
+
+        {
+            std::lock_guard lock(state_->mutex);
+
+            if (!state_->cancelled.load(std::memory_order_acquire)) {
+                const auto id = state_->nextId++;
+                state_->callbacks.emplace(id, std::move(callback));
+
+                return id;
+            }
+        }
+
+        callback();
+        return 0;
+    }
+
+    // returns true if callback is removed and would never be called,
+    // false means callback is called or is being called by cancelling thread
+    // warn: callback being called is not waited for
+    bool removeCallback(CallbackId id) const {
+        if (!state_ || id == 0) {
+            return false;
+        }
+
+        std::lock_guard lock(state_->mutex);
+        return state_->callbacks.erase(id) != 0;
+    }
+
+private:
+    explicit CancellationToken(std::shared_ptr<details::CancellationState> state) noexcept:
+        state_(std::move(state)) {}
+
+    std::shared_ptr<details::CancellationState> state_;
+
+    friend class CancellationSource;
+};
+
+// write side of cancellation, cancel is one atomic store and does not touch queued tasks,
+// queued tasks check token before start and are dropped if it is cancelled
+class CancellationSource {
+public:
+    CancellationSource():
+        state_(std::make_shared<details::CancellationState>()) {}
+
+    CancellationToken token() const noexcept {
+        return CancellationToken(state_);
+    }
+
+    // returns false if source was cancelled already
+    bool cancel() {
+        if (state_->cancelled.exchange(true, std::memory_order_acq_rel)) {
+            return false;
+        }
+
+        // callbacks added after cancelled flag is set are called by their adding thread
+        std::map<uint64_t, Task> callbacks;
+
+        {
+            std::lock_guard lock(state_->mutex);
+            callbacks.swap(state_->callbacks);
+        }
+
+        for (auto& [id, callback] : callbacks) {
+            try {
+                callback();
+            }
+            catch (...) {
+            }
+        }
+
+        return true;
+    }
+
+    bool isCancelled() const noexcept {
+        return state_->cancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    std::shared_ptr<details::CancellationState> state_;
+};
+}
+
+#endif // CS_CANCELLATION_HPP
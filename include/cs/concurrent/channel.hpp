@@ -0,0 +1,340 @@
+#ifndef CS_CHANNEL_HPP
+#define CS_CHANNEL_HPP
+
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+#include <optional>
+#include <type_traits>
+#include <condition_variable>
+
+#include <cs/signals/signals.hpp>
+#include <cs/containers/mpmc_queue.hpp>
+#include <cs/containers/spsc_queue.hpp>
+#include <cs/concurrent/details/watcher_signal.hpp>
+
+namespace cs {
+// defines count of threads which could use channel sides at once
+enum class ChannelKind : unsigned char {
+    // one sender and one receiver, wait free ring
+    Spsc,
+
+    // many senders and one receiver, the same lock free ring as Mpmc,
+    // kind only documents channel usage, single receiver makes no cheaper ring here
+    Mpsc,
+
+    // many senders and many receivers, lock free ring
+    Mpmc
+};
+
+// bounded channel, values are passed through lock free ring and threads block at mutex
+// only when channel is full or empty, closed channel rejects values and lets receivers drain it,
+// blocking calls yield once before waiting, other side often frees channel meanwhile
+// and then no thread pays for sleeping and waking up
+template <typename T, ChannelKind Kind = ChannelKind::Mpmc>
+class Channel : public details::ConnectionObserver {
+    using Queue = std::conditional_t<Kind == ChannelKind::Spsc, SpscQueue<T>, MpmcQueue<T>>;
+    using ReadySignal = details::WatcherSignal<void()>;
+
+public:
+    // capacity is rounded up to power of two
+    explicit Channel(size_t capacity):
+        ready(this), queue_(capacity) {}
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    // returns false if channel is full or closed, value is not touched then
+    bool trySend(const T& value) {
+        return trySendImpl(value);
+    }
+
+    bool trySend(T&& value) {
+        return trySendImpl(std::move(value));
+    }
+
+    // blocks while channel is full, returns false if channel is closed
+    bool send(const T& value) {
+        return sendImpl(value);
+    }
+
+    bool send(T&& value) {
+        return sendImpl(std::move(value));
+    }
+
+    // returns front value or nothing if channel is empty
+    std::optional<T> tryRecv() {
+        std::optional<T> value;
+
+        if (pop(value)) {
+            return value;
+        }
+
+        // next sender emits ready signal, value sent meanwhile is taken here
+        if (ready.isConnected()) {
+            armed_.store(true, std::memory_order_seq_cst);
+
+            if (pop(value)) {
+                return value;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    // blocks while channel is empty, returns nothing if channel is closed and empty
+    std::optional<T> recv() {
+        for (bool yielded = false;; yielded = true) {
+            if (auto value = tryRecv(); value) {
+                return value;
+            }
+
+            if (!yielded) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock(mutex_);
+
+            if (!waitForData(lock, [this](auto& lock, auto& predicate) {
+                dataNotifier_.wait(lock, predicate);
+                return true;
+            })) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    // blocks while channel is empty but not longer than timeout,
+    // returns nothing if timeout is expired or channel is closed and empty
+    template <typename Rep, typename Period>
+    std::optional<T> recvFor(const std::chrono::duration<Rep, Period>& timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        for (bool yielded = false;; yielded = true) {
+            if (auto value = tryRecv(); value) {
+                return value;
+            }
+
+            if (!yielded) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock(mutex_);
+
+            if (!waitForData(lock, [this, deadline](auto& lock, auto& predicate) {
+                return dataNotifier_.wait_until(lock, deadline, predicate);
+            })) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    // blocks until channel has values, then moves up to max values to output without blocking,
+    // returns count of received values, zero means channel is closed and empty
+    template <typename OutputIterator>
+    size_t recvMany(OutputIterator output, size_t max) {
+        if (max == 0) {
+            return 0;
+        }
+
+        for (bool yielded = false;; yielded = true) {
+            size_t count = 0;
+            std::optional<T> value;
+
+            while (count < max && queue_.tryPop(value)) {
+                *output = std::move(*value);
+                value.reset();
+
+                ++output;
+                ++count;
+            }
+
+            // senders are notified once for the whole batch
+            if (count != 0) {
+                notifySenders(count);
+                return count;
+            }
+
+            if (!yielded) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock(mutex_);
+
+            if (!waitForData(lock, [this](auto& lock, auto& predicate) {
+                dataNotifier_.wait(lock, predicate);
+                return true;
+            })) {
+                return 0;
+            }
+        }
+    }
+
+    // rejects next values and wakes all blocked threads, queued values could be received
+    void close() {
+        closed_.store(true, std::memory_order_seq_cst);
+
+        {
+            std::lock_guard lock(mutex_);
+        }
+
+        dataNotifier_.notify_all();
+        spaceNotifier_.notify_all();
+    }
+
+    bool isClosed() const noexcept {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const noexcept {
+        return queue_.capacity();
+    }
+
+    // approximate values, channel could be changed by other threads at any moment
+    size_t size() const noexcept {
+        return queue_.size();
+    }
+
+    bool isEmpty() const noexcept {
+        return queue_.isEmpty();
+    }
+
+public signals:
+    // emitted by sender thread when value arrives at channel which receiver found empty,
+    // slot should drain channel by tryRecv, emission could be spurious
+    ReadySignal ready;
+
+private:
+    void onConnected(const details::SignalConnection*) override {}
+
+    template <typename U>
+    bool trySendImpl(U&& value) {
+        if (closed_.load(std::memory_order_acquire) || !queue_.tryPush(std::forward<U>(value))) {
+            return false;
+        }
+
+        notifyReceivers();
+        return true;
+    }
+
+    template <typename U>
+    bool sendImpl(U&& value) {
+        for (bool yielded = false;; yielded = true) {
+            if (closed_.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            // value is not touched by failed push
+            if (queue_.tryPush(std::forward<U>(value))) {
+                notifyReceivers();
+                return true;
+            }
+
+            if (!yielded) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock(mutex_);
+            senders_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            spaceNotifier_.wait(lock, [this] {
+                return closed_.load(std::memory_order_seq_cst) || !queue_.isFull();
+            });
+
+            senders_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // waits by wait functor while channel is empty, returns false if channel is closed and empty or wait failed
+    template <typename Wait>
+    bool waitForData(std::unique_lock<std::mutex>& lock, Wait&& wait) {
+        receivers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto predicate = [this] {
+            return closed_.load(std::memory_order_seq_cst) || !queue_.isEmpty();
+        };
+
+        const bool woken = wait(lock, predicate);
+
+        receivers_.fetch_sub(1, std::memory_order_relaxed);
+
+        return woken && !(closed_.load(std::memory_order_acquire) && queue_.isEmpty());
+    }
+
+    bool pop(std::optional<T>& value) {
+        if (!queue_.tryPop(value)) {
+            return false;
+        }
+
+        notifySenders();
+        return true;
+    }
+
+    // blocked thread checks channel under mutex, so taking it here
+    // guarantees thread is either waiting already or would see new state
+    void notifyReceivers() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (receivers_.load(std::memory_order_relaxed) != 0) {
+            {
+                std::lock_guard lock(mutex_);
+            }
+
+            dataNotifier_.notify_one();
+        }
+
+        if (ready.isConnected() && armed_.exchange(false, std::memory_order_seq_cst)) {
+            emit ready();
+        }
+    }
+
+    // every popped value frees space for one sender, all senders are woken only by close
+    void notifySenders(size_t count = 1) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (const size_t senders = senders_.load(std::memory_order_relaxed); senders != 0) {
+            {
+                std::lock_guard lock(mutex_);
+            }
+
+            for (size_t i = std::min(count, senders); i != 0; --i) {
+                spaceNotifier_.notify_one();
+            }
+        }
+    }
+
+    Queue queue_;
+    std::atomic<bool> closed_ = { false };
+
+    // ready signal is emitted once per arming by receiver
+    std::atomic<bool> armed_ = { true };
+
+    // slow path of full or empty channel
+    std::mutex mutex_;
+    std::condition_variable dataNotifier_;
+    std::condition_variable spaceNotifier_;
+
+    cacheline_aligned std::atomic<size_t> receivers_ = { 0 };
+    std::atomic<size_t> senders_ = { 0 };
+};
+
+template <typename T>
+using SpscChannel = Channel<T, ChannelKind::Spsc>;
+
+template <typename T>
+using MpscChannel = Channel<T, ChannelKind::Mpsc>;
+
+template <typename T>
+using MpmcChannel = Channel<T, ChannelKind::Mpmc>;
+}
+
+#endif // CS_CHANNEL_HPP
@@ -1,80 +1,132 @@
 #ifndef CS_CONCURRENT_HPP
 #define CS_CONCURRENT_HPP
 
-#include <list>
+#include <tuple>
+#include <vector>
+#include <typeinfo>
 
+#include <cs/concurrent/strand.hpp>
 #include <cs/concurrent/future_watcher.hpp>
+#include <cs/concurrent/details/timer_wheel.hpp>
+#include <cs/concurrent/details/execution_registry.hpp>
 
 namespace cs {
+using TimerHandle = details::TimerHandle;
+
 class Concurrent {
-    template<typename T>
-    using Executions = std::list<T>;
+    template <typename T>
+    using Executions = details::ExecutionRegistry<FutureWatcher<T>>;
 
 public:
     // runs function in another thread, returns future watcher
     // than generates finished signal by run policy
     // you should not store watcher, it does by run method, just use finished/failed signal to subscribe
+    // task emits its result itself, so every execution takes only one thread
     template <typename Func, typename... Args>
     static FutureWatcherPtr<std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>> run(RunPolicy policy, Func&& function, Args&&... args) {
+        return Concurrent::run(CancellationToken(), policy, std::forward<Func>(function), std::forward<Args>(args)...);
+    }
+
+    // runs function like run without token, but if token is cancelled before task starts
+    // function is not called and watcher emits cancelled signal, function could poll token
+    // and throw CancelledException by token throwIfCancelled to be reported as cancelled too
+    template <typename Func, typename... Args>
+    static FutureWatcherPtr<std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>> run(const CancellationToken& token, RunPolicy policy, Func&& function, Args&&... args) {
         using ReturnType = std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>;
         using WatcherType = FutureWatcher<ReturnType>;
 
         // running executions
-        static Executions<FutureWatcherPtr<ReturnType>> executions;
-        using ExecutionsIterator = typename decltype(executions)::iterator;
+        auto& executions = Concurrent::executions<ReturnType>();
+        auto watcher = std::make_shared<WatcherType>(policy);
 
-        // run async and store it at executions
-        auto watcher = std::make_shared<WatcherType>(policy, std::async(std::launch::async, std::forward<Func>(function), std::forward<Args>(args)...));
-
-        {
-            std::lock_guard lock(executionsMutex_);
-            executions.push_back(watcher);
-        }
+        executions.add(watcher->id(), watcher);
 
         // watcher will be removed after lambda called
-        cs::Connector::connect(&watcher->completed, [storage = watcher->shared_from_this()](typename FutureWatcher<ReturnType>::Id id) {
-            ExecutionsIterator iter;
-
-            {
-                std::lock_guard lock(executionsMutex_);
-                iter = std::find_if(executions.begin(), executions.end(), [=](const auto& watcher) {
-                    return (watcher->id() == id) && (watcher->state() == WatcherState::Compeleted);
-                });
-            }
+        cs::Connector::connect(&watcher->completed, [&executions](typename FutureWatcher<ReturnType>::Id id) {
+            executions.remove(id);
+        });
+
+        watcher->state_ = WatcherState::Running;
 
-            if (iter != executions.end()) {
-                std::lock_guard lock(executionsMutex_);
-                executions.erase(iter);
+        auto closure = [watcher, token, func = std::forward<Func>(function), arguments = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+            if (token.isCancelled()) {
+                watcher->setCancelled();
             }
-        });
+            else {
+                watcher->invoke(std::move(func), std::move(arguments));
+            }
+        };
 
+        details::Worker::execute(policy, Task(std::move(closure)));
         return watcher;
     }
 
-    // calls std::function after ms time in another thread
-    // its better to do not use thread pool run policy, it can block all cs runtime pools
+    // calls function after ms time, expired callback is executed by run policy,
+    // timers are served by one timer thread, so no thread waits for timeout
     template<typename Func>
-    static void runAfter(const std::chrono::milliseconds& ms, Func&& callBack, cs::RunPolicy policy = cs::RunPolicy::Thread) {
+    static TimerHandle runAfter(const std::chrono::milliseconds& ms, Func&& callBack, cs::RunPolicy policy = cs::RunPolicy::Thread) {
         const auto timePoint = std::chrono::steady_clock::now() + ms;
-        auto binder = std::bind(&Concurrent::runAfterHelper<Func>, timePoint, std::forward(callBack));
+        return details::TimerWheel::instance().schedule(timePoint, std::chrono::milliseconds(0), policy, Task(std::forward<Func>(callBack)));
+    }
+
+    // calls function every ms time until returned handle is cancelled
+    // warn: callback would be called concurrently if it runs longer than period
+    template<typename Func>
+    static TimerHandle runEvery(const std::chrono::milliseconds& ms, Func&& callBack, cs::RunPolicy policy = cs::RunPolicy::ThreadPool) {
+        const auto period = std::max(ms, std::chrono::milliseconds(1));
+        const auto timePoint = std::chrono::steady_clock::now() + period;
 
-        details::Worker::execute(policy, std::move(binder));
+        return details::TimerWheel::instance().schedule(timePoint, period, policy, Task(std::forward<Func>(callBack)));
     }
 
     // executes function in other threads by run policy
     template <typename Func>
     static void execute(cs::RunPolicy policy, Func&& function) {
-        details::Worker::execute(policy, std::forward<Func>(function));
+        details::Worker::execute(policy, Task(std::forward<Func>(function)));
     }
 
-private:
-    template<typename Func>
-    static void runAfterHelper(const std::chrono::steady_clock::time_point& timePoint, Func&& callBack) {
-        std::this_thread::sleep_until(timePoint);
-        callBack();
+    // executes function at strand after all previously posted strand tasks
+    template <typename Func>
+    static void execute(Strand& strand, Func&& function) {
+        strand.post(std::forward<Func>(function));
     }
 
-    inline static std::mutex executionsMutex_;
+    // returns in flight executions count of run calls with Result type
+    template <typename Result>
+    static size_t executionsCount() {
+        return Concurrent::executions<Result>().size();
+    }
+
+    // returns in flight executions count of all run calls
+    static size_t executionsCount() {
+        size_t count = 0;
+
+        details::ExecutionRegistries::instance().forEach([&](const details::ExecutionRegistryBase& registry) {
+            count += registry.size();
+        });
+
+        return count;
+    }
+
+    // returns in flight executions per result type, types without executions are skipped
+    static std::vector<ExecutionsInfo> executionsInfo() {
+        std::vector<ExecutionsInfo> result;
+
+        details::ExecutionRegistries::instance().forEach([&](const details::ExecutionRegistryBase& registry) {
+            if (const auto count = registry.size(); count != 0) {
+                result.push_back(ExecutionsInfo{registry.typeName(), count});
+            }
+        });
+
+        return result;
+    }
+
+private:
+    template <typename Result>
+    static Executions<Result>& executions() {
+        static Executions<Result> executions(typeid(Result).name());
+        return executions;
+    }
 };
 }
 
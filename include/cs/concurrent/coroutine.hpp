@@ -0,0 +1,261 @@
+#ifndef CS_COROUTINE_HPP
+#define CS_COROUTINE_HPP
+
+#include <cs/utils/coroutine_support.hpp>
+
+#ifdef CS_COROUTINES_SUPPORTED
+
+#include <mutex>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <type_traits>
+#include <condition_variable>
+
+#include <cs/concurrent/concurrent.hpp>
+
+namespace cs {
+template <typename T = void>
+class CoTask;
+
+namespace details {
+// resumes awaiting coroutine by watcher task thread after watcher result is stored
+template <typename Result>
+class WatcherAwaiter {
+public:
+    explicit WatcherAwaiter(FutureWatcherPtr<Result> watcher):
+        watcher_(std::move(watcher)) {}
+
+    bool await_ready() const noexcept {
+        return watcher_->state() == WatcherState::Compeleted;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        return watcher_->addCompletionCallback(Task([handle] {
+            handle.resume();
+        }));
+    }
+
+    // returns watcher result or rethrows task exception
+    Result await_resume() {
+        if (watcher_->error_) {
+            std::rethrow_exception(watcher_->error_);
+        }
+
+        if constexpr (!std::is_void_v<Result>) {
+            return *watcher_->result_;
+        }
+    }
+
+private:
+    FutureWatcherPtr<Result> watcher_;
+};
+
+class CoPromiseBase {
+public:
+    // task is started lazily by co_await or get
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+
+    // transfers control to awaiting coroutine without stack growth
+    class FinalAwaiter {
+    public:
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            auto& promise = handle.promise();
+
+            if (promise.continuation_) {
+                return promise.continuation_;
+            }
+
+            // frame could be destroyed by waiter right after callback call
+            if (auto callback = std::move(promise.finished_); callback) {
+                callback();
+            }
+
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    void unhandled_exception() noexcept {
+        exception_ = std::current_exception();
+    }
+
+protected:
+    void rethrow() {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+    std::coroutine_handle<> continuation_;
+    Task finished_;
+    std::exception_ptr exception_;
+
+    template <typename T>
+    friend class cs::CoTask;
+};
+
+template <typename T>
+class CoPromise : public CoPromiseBase {
+public:
+    CoTask<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value) {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T result() {
+        rethrow();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class CoPromise<void> : public CoPromiseBase {
+public:
+    CoTask<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void result() {
+        rethrow();
+    }
+};
+}
+
+// lazy coroutine task, starts when it is awaited,
+// co_await pool.schedule() inside coroutine moves it to thread pool worker
+template <typename T>
+class [[nodiscard]] CoTask {
+public:
+    using promise_type = details::CoPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    CoTask(CoTask&& task) noexcept:
+        handle_(std::exchange(task.handle_, nullptr)) {}
+
+    CoTask& operator=(CoTask&& task) noexcept {
+        if (this != &task) {
+            reset();
+            handle_ = std::exchange(task.handle_, nullptr);
+        }
+
+        return *this;
+    }
+
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    ~CoTask() {
+        reset();
+    }
+
+    // returns true if coroutine is finished
+    bool isReady() const noexcept {
+        return !handle_ || handle_.done();
+    }
+
+    // starts task, awaiting coroutine is resumed by thread which finishes task
+    auto operator co_await() && noexcept {
+        class Awaiter {
+        public:
+            explicit Awaiter(Handle handle) noexcept:
+                handle_(handle) {}
+
+            bool await_ready() const noexcept {
+                return !handle_ || handle_.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle_.promise().continuation_ = awaiting;
+                return handle_;
+            }
+
+            T await_resume() {
+                return handle_.promise().result();
+            }
+
+        private:
+            Handle handle_;
+        };
+
+        return Awaiter(handle_);
+    }
+
+    // starts task and blocks current thread until task is finished,
+    // returns task result or rethrows task exception
+    T get() {
+        std::mutex mutex;
+        std::condition_variable notifier;
+        bool done = false;
+
+        if (!handle_.done()) {
+            handle_.promise().finished_ = Task([&] {
+                std::lock_guard lock(mutex);
+                done = true;
+                notifier.notify_one();
+            });
+
+            handle_.resume();
+
+            std::unique_lock lock(mutex);
+            notifier.wait(lock, [&] { return done; });
+        }
+
+        return handle_.promise().result();
+    }
+
+private:
+    explicit CoTask(Handle handle) noexcept:
+        handle_(handle) {}
+
+    void reset() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    Handle handle_;
+
+    friend class details::CoPromise<T>;
+};
+
+namespace details {
+template <typename T>
+inline CoTask<T> CoPromise<T>::get_return_object() noexcept {
+    return CoTask<T>(CoTask<T>::Handle::from_promise(*this));
+}
+
+inline CoTask<void> CoPromise<void>::get_return_object() noexcept {
+    return CoTask<void>(CoTask<void>::Handle::from_promise(*this));
+}
+}
+
+// co_await watcher suspends coroutine until watcher task is finished,
+// coroutine is resumed by task thread
+template <typename Result>
+details::WatcherAwaiter<Result> operator co_await(FutureWatcherPtr<Result> watcher) {
+    return details::WatcherAwaiter<Result>(std::move(watcher));
+}
+}
+
+#endif // CS_COROUTINES_SUPPORTED
+
+#endif // CS_COROUTINE_HPP
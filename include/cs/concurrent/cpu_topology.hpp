@@ -0,0 +1,292 @@
+#ifndef CS_CPU_TOPOLOGY_HPP
+#define CS_CPU_TOPOLOGY_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <thread>
+#include <utility>
+#include <fstream>
+#include <algorithm>
+#include <exception>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+namespace cs {
+namespace details {
+// parses kernel cpu list like 0-3,8,10-11, returns sorted processor ids
+inline std::vector<unsigned> parseCpuList(const std::string& list) {
+    std::vector<unsigned> result;
+    size_t position = 0;
+
+    while (position < list.size()) {
+        const auto end = std::min(list.find(',', position), list.size());
+        const auto range = list.substr(position, end - position);
+        position = end + 1;
+
+        const auto dash = range.find('-');
+
+        try {
+            const auto first = static_cast<unsigned>(std::stoul(range.substr(0, dash)));
+            const auto last = dash == std::string::npos ? first : static_cast<unsigned>(std::stoul(range.substr(dash + 1)));
+
+            for (auto cpu = first; cpu <= last; ++cpu) {
+                result.push_back(cpu);
+            }
+        }
+        catch (const std::exception&) {
+            // blank or broken part of list is skipped
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+}
+
+// returns first line of file or empty string if file does not exist
+inline std::string readLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+
+    std::getline(file, line);
+    return line;
+}
+
+// returns number stored at file or fallback if file is missing or broken
+inline unsigned readNumber(const std::string& path, unsigned fallback) {
+    try {
+        return static_cast<unsigned>(std::stoul(readLine(path)));
+    }
+    catch (const std::exception&) {
+        return fallback;
+    }
+}
+
+// returns sorted processors of process affinity mask or empty list if mask is not available
+inline std::vector<unsigned> allowedCpus() {
+    std::vector<unsigned> result;
+
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                result.push_back(cpu);
+            }
+        }
+    }
+#endif
+
+    return result;
+}
+
+// pins calling thread to processors, returns false if placement is not supported or rejected
+inline bool pinCurrentThread(const std::vector<unsigned>& cpus) {
+#if defined(__linux__)
+    if (cpus.empty()) {
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for (auto cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+}
+
+// processors layout, processors sharing last level cache at the same numa node form one domain,
+// threads of one domain exchange data through shared cache, other domains pay for remote access
+class CpuTopology {
+public:
+    struct Cpu {
+        unsigned id = 0;
+        unsigned node = 0;
+        unsigned package = 0;
+
+        // index of domain at domains list
+        size_t domain = 0;
+    };
+
+    // reads layout from sysfs root, every processor missing at sysfs is put to one domain,
+    // at other systems all hardware threads form one domain,
+    // not empty allowed list leaves only its processors, so workers are not placed where process could not run
+    static CpuTopology read(const std::string& root = "/sys/devices/system", const std::vector<unsigned>& allowed = {}) {
+        CpuTopology topology;
+
+#if defined(__linux__)
+        auto ids = details::parseCpuList(details::readLine(root + "/cpu/online"));
+
+        if (!allowed.empty()) {
+            ids.erase(std::remove_if(ids.begin(), ids.end(), [&](unsigned id) {
+                return !std::binary_search(allowed.begin(), allowed.end(), id);
+            }), ids.end());
+        }
+
+        // numa node of processor, missing node directory means single node system
+        std::map<unsigned, unsigned> nodes;
+
+        for (auto node : details::parseCpuList(details::readLine(root + "/node/online"))) {
+            for (auto cpu : details::parseCpuList(details::readLine(root + "/node/node" + std::to_string(node) + "/cpulist"))) {
+                nodes[cpu] = node;
+            }
+        }
+
+        // domain key is node and first processor sharing last level cache
+        std::map<std::pair<unsigned, unsigned>, size_t> domains;
+
+        for (auto id : ids) {
+            const auto path = root + "/cpu/cpu" + std::to_string(id);
+
+            Cpu cpu;
+            cpu.id = id;
+            cpu.node = nodes.count(id) != 0 ? nodes[id] : 0;
+
+            cpu.package = details::readNumber(path + "/topology/physical_package_id", 0);
+
+            const auto key = std::make_pair(cpu.node, lastCacheOwner(path, cpu.package));
+            const auto domain = domains.emplace(key, domains.size()).first->second;
+
+            cpu.domain = domain;
+            topology.cpus_.push_back(cpu);
+        }
+#else
+        (void)root;
+#endif
+
+        if (topology.cpus_.empty() && !allowed.empty()) {
+            for (auto id : allowed) {
+                Cpu cpu;
+                cpu.id = id;
+                topology.cpus_.push_back(cpu);
+            }
+        }
+        else if (topology.cpus_.empty()) {
+            const auto count = std::max(std::thread::hardware_concurrency(), 1u);
+
+            for (unsigned id = 0; id < count; ++id) {
+                Cpu cpu;
+                cpu.id = id;
+                topology.cpus_.push_back(cpu);
+            }
+        }
+
+        topology.domainsCount_ = 0;
+
+        for (const auto& cpu : topology.cpus_) {
+            topology.domainsCount_ = std::max(topology.domainsCount_, cpu.domain + 1);
+        }
+
+        return topology;
+    }
+
+    // layout of processors available to current process, read once
+    static const CpuTopology& instance() {
+        static const CpuTopology topology = read("/sys/devices/system", details::allowedCpus());
+        return topology;
+    }
+
+    const std::vector<Cpu>& cpus() const noexcept {
+        return cpus_;
+    }
+
+    size_t domainsCount() const noexcept {
+        return domainsCount_;
+    }
+
+    // returns processors of domain
+    std::vector<unsigned> domain(size_t index) const {
+        std::vector<unsigned> result;
+
+        for (const auto& cpu : cpus_) {
+            if (cpu.domain == index) {
+                result.push_back(cpu.id);
+            }
+        }
+
+        return result;
+    }
+
+    // returns domain of processor, unknown processor belongs to first domain
+    size_t domainOf(unsigned id) const noexcept {
+        for (const auto& cpu : cpus_) {
+            if (cpu.id == id) {
+                return cpu.domain;
+            }
+        }
+
+        return 0;
+    }
+
+    // returns processors taking one of every domain in turn, so first processors cover all domains
+    std::vector<unsigned> spread() const {
+        std::vector<std::vector<unsigned>> domains;
+
+        for (size_t i = 0; i < domainsCount_; ++i) {
+            domains.push_back(domain(i));
+        }
+
+        std::vector<unsigned> result;
+
+        for (size_t position = 0; result.size() < cpus_.size(); ++position) {
+            for (const auto& ids : domains) {
+                if (position < ids.size()) {
+                    result.push_back(ids[position]);
+                }
+            }
+        }
+
+        return result;
+    }
+
+private:
+    // returns first processor sharing highest cache level with processor at path,
+    // package is used if sysfs has no cache information
+    static unsigned lastCacheOwner(const std::string& path, unsigned package) {
+        unsigned level = 0;
+        unsigned owner = package;
+        bool found = false;
+
+        for (size_t index = 0;; ++index) {
+            const auto cache = path + "/cache/index" + std::to_string(index);
+            const auto cacheLevel = details::readNumber(cache + "/level", 0);
+
+            if (cacheLevel == 0) {
+                break;
+            }
+
+            const auto shared = details::parseCpuList(details::readLine(cache + "/shared_cpu_list"));
+
+            if (cacheLevel >= level && !shared.empty()) {
+                level = cacheLevel;
+                owner = shared.front();
+                found = true;
+            }
+        }
+
+        // package ids and processor ids should not collide
+        return found ? owner : package + (1u << 24);
+    }
+
+    std::vector<Cpu> cpus_;
+    size_t domainsCount_ = 1;
+};
+}
+
+#endif // CS_CPU_TOPOLOGY_HPP
@@ -6,7 +6,12 @@
 namespace cs {
 enum class RunPolicy : unsigned char {
     Thread,
-    ThreadPool
+    ThreadPool,
+
+    // named pools of ThreadPoolRegistry, compute pool is ThreadPool::instance until it is configured,
+    // blocking pool is elastic pool for io and other waiting tasks
+    Compute,
+    Blocking
 };
 
 enum class WatcherState : unsigned char {
@@ -0,0 +1,95 @@
+#ifndef CS_COMPLETION_CALLBACKS_HPP
+#define CS_COMPLETION_CALLBACKS_HPP
+
+#include <atomic>
+
+#include <cs/concurrent/task.hpp>
+
+namespace cs::details {
+// lock free one shot callbacks list, callbacks added before close are called by closing thread
+class CompletionCallbacks {
+public:
+    CompletionCallbacks() = default;
+
+    ~CompletionCallbacks() {
+        auto node = head_.load(std::memory_order_acquire);
+
+        if (node != closed()) {
+            destroy(node);
+        }
+    }
+
+    CompletionCallbacks(const CompletionCallbacks&) = delete;
+    CompletionCallbacks& operator=(const CompletionCallbacks&) = delete;
+
+    // returns false if list is closed already, callback is not called then
+    bool add(Task&& callback) {
+        auto node = new Node{std::move(callback), head_.load(std::memory_order_acquire)};
+
+        do {
+            if (node->next == closed()) {
+                callback = std::move(node->callback);
+                delete node;
+
+                return false;
+            }
+        }
+        while (!head_.compare_exchange_weak(node->next, node, std::memory_order_acq_rel, std::memory_order_acquire));
+
+        return true;
+    }
+
+    // calls all added callbacks in adding order, next add calls fail
+    void close() {
+        Node* node = head_.exchange(closed(), std::memory_order_acq_rel);
+        Node* reversed = nullptr;
+
+        while (node) {
+            auto next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+
+        while (reversed) {
+            auto next = reversed->next;
+
+            try {
+                reversed->callback();
+            }
+            catch (...) {
+            }
+
+            delete reversed;
+            reversed = next;
+        }
+    }
+
+    bool isClosed() const noexcept {
+        return head_.load(std::memory_order_acquire) == closed();
+    }
+
+private:
+    struct Node {
+        Task callback;
+        Node* next = nullptr;
+    };
+
+    static Node* closed() noexcept {
+        static Node node;
+        return &node;
+    }
+
+    static void destroy(Node* node) {
+        while (node) {
+            auto next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    std::atomic<Node*> head_ = { nullptr };
+};
+}
+
+#endif // CS_COMPLETION_CALLBACKS_HPP
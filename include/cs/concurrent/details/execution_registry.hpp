@@ -0,0 +1,143 @@
+#ifndef CS_EXECUTION_REGISTRY_HPP
+#define CS_EXECUTION_REGISTRY_HPP
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+#include <cs/utils/cache.hpp>
+
+namespace cs {
+// in flight executions of one result type
+struct ExecutionsInfo {
+    std::string type;
+    size_t count = 0;
+};
+
+namespace details {
+class ExecutionRegistryBase;
+
+// list of all typed registries, used only by introspection
+class ExecutionRegistries {
+public:
+    void add(const ExecutionRegistryBase* registry) {
+        std::lock_guard lock(mutex_);
+        registries_.push_back(registry);
+    }
+
+    void remove(const ExecutionRegistryBase* registry) {
+        std::lock_guard lock(mutex_);
+        registries_.erase(std::remove(registries_.begin(), registries_.end(), registry), registries_.end());
+    }
+
+    template <typename Func>
+    void forEach(Func&& func) const {
+        std::lock_guard lock(mutex_);
+
+        for (auto registry : registries_) {
+            func(*registry);
+        }
+    }
+
+    static ExecutionRegistries& instance() {
+        static ExecutionRegistries registries;
+        return registries;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<const ExecutionRegistryBase*> registries_;
+};
+
+class ExecutionRegistryBase {
+public:
+    // returns in flight executions count
+    size_t size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    const char* typeName() const noexcept {
+        return typeName_;
+    }
+
+protected:
+    explicit ExecutionRegistryBase(const char* typeName):
+        typeName_(typeName) {
+        ExecutionRegistries::instance().add(this);
+    }
+
+    ~ExecutionRegistryBase() {
+        ExecutionRegistries::instance().remove(this);
+    }
+
+    ExecutionRegistryBase(const ExecutionRegistryBase&) = delete;
+    ExecutionRegistryBase& operator=(const ExecutionRegistryBase&) = delete;
+
+    const char* const typeName_;
+    std::atomic<size_t> size_ = { 0 };
+};
+
+// keeps running executions alive, executions are spread by id between shards,
+// so add and remove are O(1) and completions of different shards never contend
+template <typename Execution>
+class ExecutionRegistry : public ExecutionRegistryBase {
+public:
+    using Id = uint64_t;
+    using Pointer = std::shared_ptr<Execution>;
+
+    constexpr static size_t shardsCount = 16;
+
+    explicit ExecutionRegistry(const char* typeName):
+        ExecutionRegistryBase(typeName) {}
+
+    void add(Id id, Pointer execution) {
+        auto& shard = shards_[id % shardsCount];
+
+        {
+            std::lock_guard lock(shard.mutex);
+            shard.executions.emplace(id, std::move(execution));
+        }
+
+        size_.fetch_add(1, std::memory_order_release);
+    }
+
+    // returns false if there is no execution with id
+    bool remove(Id id) {
+        auto& shard = shards_[id % shardsCount];
+        Pointer execution;
+
+        {
+            std::lock_guard lock(shard.mutex);
+            auto iter = shard.executions.find(id);
+
+            if (iter == shard.executions.end()) {
+                return false;
+            }
+
+            // execution is destroyed out of lock
+            execution = std::move(iter->second);
+            shard.executions.erase(iter);
+        }
+
+        size_.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct cacheline_aligned Shard {
+        std::mutex mutex;
+        std::unordered_map<Id, Pointer> executions;
+    };
+
+    std::array<Shard, shardsCount> shards_;
+};
+}
+}
+
+#endif // CS_EXECUTION_REGISTRY_HPP
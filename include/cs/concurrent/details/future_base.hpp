@@ -1,23 +1,27 @@
 #ifndef CS_FUTURE_BASE_HPP
 #define CS_FUTURE_BASE_HPP
 
+#include <atomic>
 #include <memory>
 
 #include <cs/signals/signals.hpp>
 #include <cs/concurrent/details/worker.hpp>
+#include <cs/concurrent/details/watcher_signal.hpp>
+#include <cs/concurrent/details/completion_callbacks.hpp>
 
 namespace cs {
 namespace details {
+// result delivery protocol: task stores result and marks watcher completed,
+// result is emitted by task thread if result signal is connected already,
+// otherwise first subscription dispatches emission by run policy, so nobody sleeps or polls
 template <typename Result>
-class FutureBase : public std::enable_shared_from_this<FutureBase<Result>> {
+class FutureBase : public std::enable_shared_from_this<FutureBase<Result>>, public ConnectionObserver {
 public:
     using Id = uint64_t;
 
 protected:
     FutureBase() {
-        ++producedId;
-
-        id_ = producedId;
+        id_ = producedId.fetch_add(1, std::memory_order_relaxed) + 1;
         state_ = WatcherState::Idle;
         policy_ = RunPolicy::Thread;
     }
@@ -25,16 +29,20 @@ protected:
     FutureBase(FutureBase&) = delete;
     ~FutureBase() = default;
 
-    explicit FutureBase(const RunPolicy policy, Future<Result>&& future)
+    explicit FutureBase(const RunPolicy policy)
     : FutureBase() {
-        future_ = std::move(future);
         policy_ = policy;
     }
 
+    explicit FutureBase(const RunPolicy policy, Future<Result>&& future)
+    : FutureBase(policy) {
+        future_ = std::move(future);
+    }
+
     FutureBase(FutureBase&& watcher) noexcept
     : future_(std::move(watcher.future_))
     , policy_(watcher.policy_)
-    , state_(watcher.state_)
+    , state_(watcher.state_.load())
     , id_(watcher.id_) {
     }
 
@@ -44,7 +52,7 @@ public:
     // returns current watcher state, if watcher never watched runnable entity
     // then his state is Idle
     WatcherState state() const noexcept {
-        return state_;
+        return state_.load(std::memory_order_acquire);
     }
 
     Id id() const noexcept {
@@ -56,29 +64,72 @@ protected:
 
     Future<Result> future_;
     RunPolicy policy_;
-    WatcherState state_ = WatcherState::Idle;
+    std::atomic<WatcherState> state_ = { WatcherState::Idle };
     Id id_;
 
-    inline static Id producedId = 0;
-    constexpr static std::chrono::milliseconds awaiterTime{10};
+    inline static std::atomic<Id> producedId = { 0 };
 
+    // emits finished or failed signal with stored result
+    virtual void emitResult() = 0;
+
+    // returns signal which would receive stored result, valid after completion
+    virtual const SignalConnection* resultSignal() const = 0;
+
+    // should be called by task thread after result or error is stored
     void setCompletedState() {
         future_ = Future<Result>();
-        state_ = WatcherState::Compeleted;
+        state_.store(WatcherState::Compeleted, std::memory_order_release);
+
+        completed_.store(true, std::memory_order_seq_cst);
+
+        if (resultSignal()->isConnected()) {
+            deliver();
+        }
 
         emit completed(id_);
+
+        callbacks_.close();
     }
 
-    // TODO: try to find more optimaze realization
-    template <typename Awaiter>
-    void await(const Awaiter& awaiter) {
-        if (cs::Connector::callbacks(&awaiter) != 0) {
+    // adds callback called once by task thread after result emission,
+    // returns false if watcher is completed already
+    bool addCompletionCallback(Task&& callback) {
+        return callbacks_.add(std::move(callback));
+    }
+
+    void onConnected(const SignalConnection* connection) override {
+        if (!completed_.load(std::memory_order_seq_cst) || delivered_.load(std::memory_order_acquire)) {
             return;
         }
 
-        std::this_thread::sleep_for(awaiterTime);
+        if (connection != resultSignal()) {
+            return;
+        }
+
+        // connection is made under connector lock, so late result is emitted by run policy executor
+        auto self = this->weak_from_this().lock();
+
+        try {
+            details::Worker::execute(policy_, Task([this, self] {
+                deliver();
+            }));
+        }
+        catch (...) {
+        }
+    }
+
+private:
+    void deliver() {
+        if (!delivered_.exchange(true, std::memory_order_acq_rel)) {
+            emitResult();
+        }
     }
 
+    std::atomic<bool> completed_ = { false };
+    std::atomic<bool> delivered_ = { false };
+
+    CompletionCallbacks callbacks_;
+
 protected signals:
 
     // internal utility signal, clients should used finished/failed signals from FutureWatcher
@@ -0,0 +1,413 @@
+#ifndef CS_TIMER_WHEEL_HPP
+#define CS_TIMER_WHEEL_HPP
+
+#include <array>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <limits>
+#include <cstdint>
+#include <condition_variable>
+
+#include <cs/concurrent/task.hpp>
+#include <cs/concurrent/details/common.hpp>
+#include <cs/concurrent/details/worker.hpp>
+
+namespace cs::details {
+class TimerWheel;
+
+// scheduled timer, linked to wheel slot while pending
+struct TimerNode {
+    Task callback;
+    RunPolicy policy = RunPolicy::Thread;
+
+    // expiration and period in wheel ticks, zero period means single shot timer
+    uint64_t expiry = 0;
+    uint64_t period = 0;
+
+    std::atomic<bool> cancelled = { false };
+
+    // intrusive slot list, guarded by wheel mutex
+    TimerNode* previous = nullptr;
+    TimerNode* next = nullptr;
+    TimerNode** head = nullptr;
+
+    // wheel keeps node alive while it is linked
+    std::shared_ptr<TimerNode> self;
+};
+
+// cancellable reference to scheduled timer
+class TimerHandle {
+public:
+    TimerHandle() = default;
+
+    // stops timer, already dispatched but not started callbacks are skipped,
+    // returns false if timer was already finished or cancelled
+    bool cancel();
+
+    // returns true if timer would fire again
+    bool isActive() const;
+
+private:
+    TimerHandle(TimerWheel* wheel, std::weak_ptr<TimerNode> node):
+        wheel_(wheel), node_(std::move(node)) {}
+
+    TimerWheel* wheel_ = nullptr;
+    std::weak_ptr<TimerNode> node_;
+
+    friend class TimerWheel;
+};
+
+// hierarchical timing wheel with one timer thread,
+// insert and cancel are O(1), expired callbacks are dispatched by run policy
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Tick = std::chrono::milliseconds;
+
+    TimerWheel();
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // schedules callback at time point, non zero period makes timer periodic
+    TimerHandle schedule(Clock::time_point timePoint, Tick period, RunPolicy policy, Task&& callback);
+
+    // returns pending timers count
+    size_t size() const;
+
+    // returns process wide wheel, timer thread starts with first timer
+    static TimerWheel& instance();
+
+private:
+    constexpr static size_t levelBits = 6;
+    constexpr static size_t slotsCount = size_t(1) << levelBits;
+    constexpr static size_t slotsMask = slotsCount - 1;
+    constexpr static size_t levelsCount = 4;
+
+    // maximal ticks distance, far timers are placed at last level and recascaded
+    constexpr static uint64_t maxDistance = (uint64_t(1) << (levelBits * levelsCount)) - 1;
+
+    struct Slot {
+        TimerNode* head = nullptr;
+    };
+
+    uint64_t toTicks(Clock::time_point timePoint) const;
+    Clock::time_point toTimePoint(uint64_t ticks) const;
+
+    void link(TimerNode* node);
+    void unlink(TimerNode* node);
+
+    // moves timers of level slot to lower levels
+    void cascade(size_t level);
+
+    // processes ticks up to argument, expired nodes are added to vector
+    void advance(uint64_t ticks, std::vector<std::shared_ptr<TimerNode>>& expired);
+
+    // returns tick of next possible event
+    uint64_t nextEventTick() const;
+
+    void dispatch(const std::shared_ptr<TimerNode>& node);
+
+    bool cancel(const std::shared_ptr<TimerNode>& node);
+    bool isActive(const std::shared_ptr<TimerNode>& node) const;
+
+    void routine();
+
+    const Clock::time_point start_;
+
+    std::array<std::array<Slot, slotsCount>, levelsCount> levels_;
+    uint64_t now_ = 0;
+    uint64_t wakeTick_ = std::numeric_limits<uint64_t>::max();
+    size_t size_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable notifier_;
+
+    std::thread thread_;
+    bool stop_ = false;
+
+    friend class TimerHandle;
+};
+
+inline bool TimerHandle::cancel() {
+    auto node = node_.lock();
+    return node && wheel_ ? wheel_->cancel(node) : false;
+}
+
+inline bool TimerHandle::isActive() const {
+    auto node = node_.lock();
+    return node && wheel_ ? wheel_->isActive(node) : false;
+}
+
+inline TimerWheel::TimerWheel():
+    start_(Clock::now()) {
+}
+
+inline TimerWheel::~TimerWheel() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+
+    notifier_.notify_one();
+
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    // break self references of never fired timers
+    for (auto& level : levels_) {
+        for (auto& slot : level) {
+            while (slot.head) {
+                auto node = slot.head;
+                unlink(node);
+                node->self.reset();
+            }
+        }
+    }
+}
+
+inline TimerHandle TimerWheel::schedule(Clock::time_point timePoint, Tick period, RunPolicy policy, Task&& callback) {
+    auto node = std::make_shared<TimerNode>();
+    node->callback = std::move(callback);
+    node->policy = policy;
+    node->period = static_cast<uint64_t>(std::max<Tick::rep>(period.count(), 0));
+    node->self = node;
+
+    bool notify = false;
+
+    {
+        std::lock_guard lock(mutex_);
+
+        node->expiry = std::max(toTicks(timePoint), now_ + 1);
+        link(node.get());
+
+        if (!thread_.joinable()) {
+            thread_ = std::thread(&TimerWheel::routine, this);
+        }
+
+        notify = node->expiry < wakeTick_;
+    }
+
+    if (notify) {
+        notifier_.notify_one();
+    }
+
+    return TimerHandle(this, node);
+}
+
+inline size_t TimerWheel::size() const {
+    std::lock_guard lock(mutex_);
+    return size_;
+}
+
+inline TimerWheel& TimerWheel::instance() {
+    // pools should outlive wheel, they could receive expired timers until timer thread stops
+    ThreadPool::instance();
+    Worker::threadsCache();
+    ThreadPoolRegistry::instance();
+
+    static TimerWheel wheel;
+    return wheel;
+}
+
+inline uint64_t TimerWheel::toTicks(Clock::time_point timePoint) const {
+    if (timePoint <= start_) {
+        return 0;
+    }
+
+    // round up, timer never fires earlier than requested
+    const auto duration = timePoint - start_;
+    auto ticks = std::chrono::duration_cast<Tick>(duration);
+
+    if (ticks < duration) {
+        ++ticks;
+    }
+
+    return static_cast<uint64_t>(ticks.count());
+}
+
+inline TimerWheel::Clock::time_point TimerWheel::toTimePoint(uint64_t ticks) const {
+    return start_ + Tick(static_cast<Tick::rep>(ticks));
+}
+
+inline void TimerWheel::link(TimerNode* node) {
+    const uint64_t distance = node->expiry > now_ ? node->expiry - now_ : 0;
+    const uint64_t expiry = distance > maxDistance ? now_ + maxDistance : node->expiry;
+
+    size_t level = 0;
+
+    while (level + 1 < levelsCount && distance >= (uint64_t(1) << (levelBits * (level + 1)))) {
+        ++level;
+    }
+
+    auto& slot = levels_[level][(expiry >> (levelBits * level)) & slotsMask];
+
+    node->previous = nullptr;
+    node->next = slot.head;
+    node->head = &slot.head;
+
+    if (slot.head) {
+        slot.head->previous = node;
+    }
+
+    slot.head = node;
+    ++size_;
+}
+
+inline void TimerWheel::unlink(TimerNode* node) {
+    if (node->previous) {
+        node->previous->next = node->next;
+    }
+    else {
+        *node->head = node->next;
+    }
+
+    if (node->next) {
+        node->next->previous = node->previous;
+    }
+
+    node->previous = nullptr;
+    node->next = nullptr;
+    node->head = nullptr;
+    --size_;
+}
+
+inline void TimerWheel::cascade(size_t level) {
+    auto& slot = levels_[level][(now_ >> (levelBits * level)) & slotsMask];
+    TimerNode* node = slot.head;
+
+    slot.head = nullptr;
+
+    while (node) {
+        TimerNode* next = node->next;
+
+        --size_;
+        link(node);
+
+        node = next;
+    }
+}
+
+inline void TimerWheel::advance(uint64_t ticks, std::vector<std::shared_ptr<TimerNode>>& expired) {
+    while (now_ < ticks) {
+        ++now_;
+
+        for (size_t level = 1; level < levelsCount; ++level) {
+            if ((now_ & ((uint64_t(1) << (levelBits * level)) - 1)) != 0) {
+                break;
+            }
+
+            cascade(level);
+        }
+
+        auto& slot = levels_[0][now_ & slotsMask];
+
+        while (slot.head) {
+            TimerNode* node = slot.head;
+            unlink(node);
+
+            // far timer reached last level position earlier than its expiry
+            if (node->expiry > now_) {
+                link(node);
+                continue;
+            }
+
+            expired.push_back(node->self);
+
+            if (node->period != 0) {
+                node->expiry += node->period;
+                link(node);
+            }
+            else {
+                node->self.reset();
+            }
+        }
+    }
+}
+
+inline uint64_t TimerWheel::nextEventTick() const {
+    if (size_ == 0) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+
+    // nearest non empty slot of first level or next cascade
+    for (uint64_t tick = now_ + 1;; ++tick) {
+        if (levels_[0][tick & slotsMask].head || (tick & slotsMask) == 0) {
+            return tick;
+        }
+    }
+}
+
+inline void TimerWheel::dispatch(const std::shared_ptr<TimerNode>& node) {
+    try {
+        Worker::execute(node->policy, Task([node] {
+            if (!node->cancelled.load(std::memory_order_acquire)) {
+                node->callback();
+            }
+        }));
+    }
+    catch (...) {
+        // executor is not available, timer thread should survive
+    }
+}
+
+inline bool TimerWheel::cancel(const std::shared_ptr<TimerNode>& node) {
+    std::lock_guard lock(mutex_);
+
+    if (node->cancelled.exchange(true, std::memory_order_acq_rel) || node->head == nullptr) {
+        return false;
+    }
+
+    unlink(node.get());
+    node->self.reset();
+
+    return true;
+}
+
+inline bool TimerWheel::isActive(const std::shared_ptr<TimerNode>& node) const {
+    std::lock_guard lock(mutex_);
+    return node->head != nullptr && !node->cancelled.load(std::memory_order_acquire);
+}
+
+inline void TimerWheel::routine() {
+    std::vector<std::shared_ptr<TimerNode>> expired;
+    std::unique_lock lock(mutex_);
+
+    while (!stop_) {
+        const auto elapsed = std::chrono::duration_cast<Tick>(Clock::now() - start_);
+        advance(static_cast<uint64_t>(elapsed.count()), expired);
+
+        if (!expired.empty()) {
+            lock.unlock();
+
+            for (auto& node : expired) {
+                dispatch(node);
+            }
+
+            expired.clear();
+            lock.lock();
+
+            continue;
+        }
+
+        wakeTick_ = nextEventTick();
+
+        if (wakeTick_ == std::numeric_limits<uint64_t>::max()) {
+            notifier_.wait(lock);
+        }
+        else {
+            notifier_.wait_until(lock, toTimePoint(wakeTick_));
+        }
+
+        wakeTick_ = std::numeric_limits<uint64_t>::max();
+    }
+}
+}
+
+#endif // CS_TIMER_WHEEL_HPP
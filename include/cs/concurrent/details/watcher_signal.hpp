@@ -0,0 +1,67 @@
+#ifndef CS_WATCHER_SIGNAL_HPP
+#define CS_WATCHER_SIGNAL_HPP
+
+#include <atomic>
+#include <utility>
+
+#include <cs/signals/signals.hpp>
+
+namespace cs::details {
+// connection flag of observed signal
+class SignalConnection {
+public:
+    bool isConnected() const noexcept {
+        return connected_.load(std::memory_order_seq_cst);
+    }
+
+protected:
+    std::atomic<bool> connected_ = { false };
+};
+
+// gets notification when slot is connected to observed signal
+class ConnectionObserver {
+public:
+    virtual ~ConnectionObserver() = default;
+    virtual void onConnected(const SignalConnection* connection) = 0;
+};
+
+// signal which notifies its owner about every new connection,
+// so watcher could deliver already ready result to late subscriber
+template <typename T>
+class WatcherSignal : public cs::Signal<T>, public SignalConnection {
+    using Super = cs::Signal<T>;
+
+public:
+    explicit WatcherSignal(ConnectionObserver* observer):
+        observer_(observer) {}
+
+    WatcherSignal(WatcherSignal&& signal, ConnectionObserver* observer):
+        Super(std::move(signal)), observer_(observer) {
+        connected_.store(signal.isConnected(), std::memory_order_relaxed);
+    }
+
+private:
+    // called by Connector under its lock
+    template <typename U>
+    auto& add(U&& slot, details::ObjectPointer obj = nullptr) {
+        Super::add(std::forward<U>(slot), obj);
+
+        if (Super::size() != 0) {
+            connected_.store(true, std::memory_order_seq_cst);
+
+            if (observer_ != nullptr) {
+                observer_->onConnected(this);
+            }
+        }
+
+        return *this;
+    }
+
+    using Super::operator=;
+
+    ConnectionObserver* observer_ = nullptr;
+    friend class cs::Connector;
+};
+}
+
+#endif // CS_WATCHER_SIGNAL_HPP
@@ -3,8 +3,10 @@
 
 #include <thread>
 
+#include <cs/concurrent/task.hpp>
 #include <cs/concurrent/details/common.hpp>
 #include <cs/concurrent/thread_pool.hpp>
+#include <cs/concurrent/thread_pool_registry.hpp>
 
 namespace cs {
 template <typename T>
@@ -14,34 +16,58 @@ class Concurrent;
 namespace details {
 template <typename T>
 class FutureBase;
+class TimerWheel;
+
+// maximal threads count of RunPolicy::Thread
+constexpr size_t threadsCacheSize = 1024;
 
 // concurrent private helper
 class Worker {
 private:
-    template <typename Func>
-    static void runThreadPool(Func&& function) {
+    static void runThreadPool(Task&& task) {
         auto& threadPool = ThreadPool::instance();
-        threadPool.enqueue(std::forward<Func>(function));
+        threadPool.enqueue(std::move(task));
     }
 
-    template <typename Func>
-    static void runThread(Func&& function) {
-        try {
-            std::thread thread(std::forward<Func>(function));
-            thread.detach();
-        }
-        catch (...) {
-            runThreadPool(std::forward<Func>(function));
-        }
+    // task gets parked cached thread or new one while cache is not full
+    static void runThread(Task&& task) {
+        threadsCache().enqueue(std::move(task));
     }
 
-    template <typename Func>
-    static void execute(RunPolicy policy, Func&& function) {
-        if (policy == RunPolicy::Thread) {
-            runThread(std::forward<Func>(function));
-        }
-        else {
-            runThreadPool(std::forward<Func>(function));
+    // elastic pool without permanent workers, threads retire after minute without tasks
+    static ThreadPool& threadsCache() {
+        static ThreadPool cache([] {
+            ThreadPoolOptions options;
+            options.threadsCount = 0;
+            options.maxThreadsCount = threadsCacheSize;
+            options.idleTimeout = std::chrono::seconds(60);
+
+            // every task gets own thread, so nested task never waits at slot of its owner
+            options.nextTaskSlot = false;
+
+            return options;
+        }());
+
+        return cache;
+    }
+
+    static void execute(RunPolicy policy, Task&& task) {
+        switch (policy) {
+        case RunPolicy::Thread:
+            runThread(std::move(task));
+            break;
+
+        case RunPolicy::ThreadPool:
+            runThreadPool(std::move(task));
+            break;
+
+        case RunPolicy::Compute:
+            ThreadPoolRegistry::instance().enqueueCompute(std::move(task));
+            break;
+
+        case RunPolicy::Blocking:
+            ThreadPoolRegistry::instance().enqueueBlocking(std::move(task));
+            break;
         }
     }
 
@@ -51,6 +77,7 @@ private:
     template <typename T>
     friend class cs::FutureWatcher;
     friend class cs::Concurrent;
+    friend class TimerWheel;
 };
 } // details
 }
@@ -0,0 +1,83 @@
+#ifndef CS_EVENT_HPP
+#define CS_EVENT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <cs/utils/details/futex.hpp>
+
+namespace cs {
+// manual reset event, set wakes all waiting threads and event stays set until reset,
+// waiting threads sleep at futex, set and reset cost one atomic operation while nobody waits
+class Event {
+public:
+    explicit Event(bool set = false) noexcept:
+        state_(set ? 1 : 0) {}
+
+    Event(const Event&) = delete;
+    Event& operator=(const Event&) = delete;
+
+    void set() {
+        if (state_.exchange(1, std::memory_order_seq_cst) == 0 && waiters_.load(std::memory_order_seq_cst) != 0) {
+            details::futexWake(state_, details::futexWakeAll);
+        }
+    }
+
+    void reset() noexcept {
+        state_.store(0, std::memory_order_release);
+    }
+
+    bool isSet() const noexcept {
+        return state_.load(std::memory_order_acquire) != 0;
+    }
+
+    // blocks until event is set
+    void wait() {
+        if (isSet()) {
+            return;
+        }
+
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+
+        while (state_.load(std::memory_order_seq_cst) == 0) {
+            details::futexWait(state_, 0);
+        }
+
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // returns false if timeout is expired before event is set
+    template <typename Rep, typename Period>
+    bool waitFor(const std::chrono::duration<Rep, Period>& timeout) {
+        return waitUntil(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+    }
+
+    bool waitUntil(std::chrono::steady_clock::time_point deadline) {
+        if (isSet()) {
+            return true;
+        }
+
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+
+        while (state_.load(std::memory_order_seq_cst) == 0) {
+            const auto timeout = details::futexTimeout(deadline);
+
+            if (timeout.count() == 0) {
+                break;
+            }
+
+            details::futexWait(state_, 0, timeout);
+        }
+
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return isSet();
+    }
+
+private:
+    details::FutexWord state_;
+    std::atomic<uint32_t> waiters_ = { 0 };
+};
+}
+
+#endif // CS_EVENT_HPP
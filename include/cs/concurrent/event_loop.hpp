@@ -0,0 +1,271 @@
+#ifndef CS_EVENT_LOOP_HPP
+#define CS_EVENT_LOOP_HPP
+
+#include <tuple>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <type_traits>
+
+#include <cs/utils/cache.hpp>
+#include <cs/utils/pause.hpp>
+#include <cs/logger/logger.hpp>
+#include <cs/concurrent/task.hpp>
+#include <cs/utils/details/futex.hpp>
+
+namespace cs {
+// dispatcher of posted tasks and timers at one thread, loop is driven by exec or processEvents,
+// every wake up drains all tasks posted before it, so burst of posts costs one wake up,
+// tasks are executed in posting order, delayed tasks by their time and posting order
+// warn: exec and processEvents should be called by one thread at a time
+class EventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    EventLoop():
+        head_(new Node), tail_(head_.load(std::memory_order_relaxed)) {}
+
+    ~EventLoop() {
+        while (tail_) {
+            delete std::exchange(tail_, tail_->next.load(std::memory_order_relaxed));
+        }
+    }
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // lock free push from any thread, sleeping loop is woken only by the first post
+    template <typename Func>
+    void post(Func&& func) {
+        push(Task(std::forward<Func>(func)));
+    }
+
+    // runs func at loop thread not earlier than delay passes,
+    // timer of other thread is added to loop timers by posted task
+    template <typename Func>
+    void postDelayed(std::chrono::milliseconds delay, Func&& func) {
+        Timer timer{Clock::now() + delay, 0, Task(std::forward<Func>(func))};
+
+        if (isCurrent()) {
+            addTimer(std::move(timer));
+        }
+        else {
+            push(Task([this, timer = std::move(timer)]() mutable {
+                addTimer(std::move(timer));
+            }));
+        }
+    }
+
+    // returns callable that posts func call with copied arguments to loop,
+    // use it as signal slot to deliver signal at loop thread
+    template <typename Func>
+    auto wrap(Func&& func) {
+        return [this, function = std::make_shared<std::decay_t<Func>>(std::forward<Func>(func))](auto&&... args) {
+            push(Task([function, arguments = std::make_tuple(std::decay_t<decltype(args)>(std::forward<decltype(args)>(args))...)]() mutable {
+                std::apply(*function, std::move(arguments));
+            }));
+        };
+    }
+
+    // runs expired timers and tasks posted before the call without waiting, returns executed tasks count
+    size_t processEvents() {
+        auto previous = std::exchange(current_, this);
+        size_t count = runTimers();
+
+        // tasks posted by running tasks wait for next call, so posting task does not hold loop
+        Node* last = head_.load(std::memory_order_acquire);
+
+        while (tail_ != last) {
+            run(pop());
+            ++count;
+        }
+
+        current_ = previous;
+        return count;
+    }
+
+    // processes events and sleeps between them until quit is called
+    void exec() {
+        while (!quit_.load(std::memory_order_acquire)) {
+            processEvents();
+
+            if (!quit_.load(std::memory_order_acquire)) {
+                sleep();
+            }
+        }
+
+        quit_.store(false, std::memory_order_release);
+    }
+
+    // makes exec return after current task, quit before exec makes next exec return at once
+    void quit() {
+        // pairs with sleeping loop which stores state before it checks quit, like push with head
+        quit_.store(true, std::memory_order_seq_cst);
+        wake();
+    }
+
+    // returns true if current thread processes this loop events
+    bool isCurrent() const noexcept {
+        return current_ == this;
+    }
+
+    // returns loop of current thread or nullptr
+    static EventLoop* current() noexcept {
+        return current_;
+    }
+
+private:
+    enum State : uint32_t {
+        Running,
+        Sleeping
+    };
+
+    struct Node {
+        Task task;
+        std::atomic<Node*> next = { nullptr };
+    };
+
+    // delayed tasks are min heap by time, sequence keeps posting order of equal times
+    struct Timer {
+        Clock::time_point timePoint;
+        uint64_t sequence;
+        Task task;
+
+        bool operator>(const Timer& timer) const noexcept {
+            return timePoint != timer.timePoint ? timePoint > timer.timePoint : sequence > timer.sequence;
+        }
+    };
+
+    void push(Task&& task) {
+        auto node = new Node;
+        node->task = std::move(task);
+
+        auto previous = head_.exchange(node, std::memory_order_seq_cst);
+        previous->next.store(node, std::memory_order_release);
+
+        wake();
+    }
+
+    void wake() {
+        if (state_.load(std::memory_order_seq_cst) == Sleeping && state_.exchange(Running, std::memory_order_seq_cst) == Sleeping) {
+            details::futexWake(state_, 1);
+        }
+    }
+
+    // loop announces sleep before the last queue check, so post after the check sees it and wakes loop
+    void sleep() {
+        state_.store(Sleeping, std::memory_order_seq_cst);
+
+        if (head_.load(std::memory_order_seq_cst) == tail_ && !quit_.load(std::memory_order_seq_cst)) {
+            const auto timeout = timers_.empty() ? std::chrono::nanoseconds(-1) : details::futexTimeout(timers_.front().timePoint);
+
+            if (timeout.count() != 0) {
+                details::futexWait(state_, Sleeping, timeout);
+            }
+        }
+
+        state_.store(Running, std::memory_order_relaxed);
+    }
+
+    void addTimer(Timer&& timer) {
+        timer.sequence = timersSequence_++;
+
+        timers_.push_back(std::move(timer));
+        std::push_heap(timers_.begin(), timers_.end(), std::greater<>());
+    }
+
+    // timers added by running timers have later time, so loop ends
+    size_t runTimers() {
+        size_t count = 0;
+        const auto now = Clock::now();
+
+        while (!timers_.empty() && timers_.front().timePoint <= now) {
+            std::pop_heap(timers_.begin(), timers_.end(), std::greater<>());
+
+            Task task = std::move(timers_.back().task);
+            timers_.pop_back();
+
+            run(std::move(task));
+            ++count;
+        }
+
+        return count;
+    }
+
+    // single consumer pop, pushed task could be not linked by producer yet
+    Task pop() {
+        Node* next = tail_->next.load(std::memory_order_acquire);
+
+        while (next == nullptr) {
+            details::cpuPause();
+            next = tail_->next.load(std::memory_order_acquire);
+        }
+
+        Task task = std::move(next->task);
+        delete std::exchange(tail_, next);
+
+        return task;
+    }
+
+    static void run(Task&& task) {
+        try {
+            task();
+        }
+        catch (const std::exception& exception) {
+            cslog() << "EventLoop task failed, " << exception.what();
+        }
+        catch (...) {
+            cslog() << "EventLoop task failed with unknown exception";
+        }
+    }
+
+    inline static thread_local EventLoop* current_ = nullptr;
+
+    cacheline_aligned std::atomic<Node*> head_;
+    cacheline_aligned details::FutexWord state_ = { Running };
+    std::atomic<bool> quit_ = { false };
+
+    // consumer side, touched only by loop thread
+    cacheline_aligned Node* tail_;
+    std::vector<Timer> timers_;
+    uint64_t timersSequence_ = 0;
+};
+
+// thread which runs event loop until destruction, tasks left at queue are not executed
+class EventLoopThread {
+public:
+    EventLoopThread():
+        thread_([this] {
+            loop_.exec();
+        }) {}
+
+    ~EventLoopThread() {
+        loop_.quit();
+        thread_.join();
+    }
+
+    EventLoopThread(const EventLoopThread&) = delete;
+    EventLoopThread& operator=(const EventLoopThread&) = delete;
+
+    EventLoop& loop() noexcept {
+        return loop_;
+    }
+
+    std::thread::id id() const noexcept {
+        return thread_.get_id();
+    }
+
+private:
+    EventLoop loop_;
+    std::thread thread_;
+};
+}
+
+#endif // CS_EVENT_LOOP_HPP
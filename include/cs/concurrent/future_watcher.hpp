@@ -1,127 +1,390 @@
 #ifndef CS_FUTURE_HPP
 #define CS_FUTURE_HPP
 
+#include <tuple>
+#include <memory>
 #include <cstddef>
 #include <future>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <type_traits>
 
 #include <cs/logger/logger.hpp>
 #include <cs/signals/signals.hpp>
 
+#include <cs/concurrent/cancellation.hpp>
 #include <cs/concurrent/details/future_base.hpp>
 
 namespace cs {
 class Concurrent;
 
+namespace details {
+template <typename Result>
+class WatcherAwaiter;
+class WatcherCombinators;
+}
+
+template <typename T>
+class FutureWatcher;
+
+// safe pointer to watcher
+template <typename T>
+using FutureWatcherPtr = std::shared_ptr<FutureWatcher<T>>;
+
 // object to get future result from concurrent
 // generates signal when finished
-// policy used to control backend future to await result
+// result is emitted by task thread itself, late subscriber gets it by run policy
 template <typename Result>
 class FutureWatcher : public details::FutureBase<Result> {
-    using FinishSignal = cs::Signal<void(const Result&)>;
-    using FailedSignal = cs::Signal<void()>;
+    using FinishSignal = details::WatcherSignal<void(const Result&)>;
+    using FailedSignal = details::WatcherSignal<void()>;
+    using CancelledSignal = details::WatcherSignal<void()>;
 
 public:
     explicit FutureWatcher(RunPolicy policy, Future<Result>&& future):
-        details::FutureBase<Result>(policy, std::move(future)) {
+        details::FutureBase<Result>(policy, std::move(future)), finished(this), failed(this), cancelled(this) {
         watch();
     }
 
-    FutureWatcher() = default;
+    // watcher which result is set by running task
+    explicit FutureWatcher(RunPolicy policy):
+        details::FutureBase<Result>(policy), finished(this), failed(this), cancelled(this) {
+    }
+
+    FutureWatcher():
+        finished(this), failed(this), cancelled(this) {
+    }
+
     ~FutureWatcher() = default;
-    FutureWatcher(FutureWatcher&&) = default;
+
+    FutureWatcher(FutureWatcher&& watcher):
+        details::FutureBase<Result>(std::move(watcher)),
+        finished(std::move(watcher.finished), this),
+        failed(std::move(watcher.failed), this),
+        cancelled(std::move(watcher.cancelled), this),
+        result_(std::move(watcher.result_)),
+        error_(std::move(watcher.error_)),
+        cancelled_(watcher.cancelled_) {
+    }
 
     FutureWatcher& operator=(FutureWatcher&& watcher) = delete;
 
+    // runs func with result by policy after watcher is finished, returns watcher of func result,
+    // failure or cancellation of this watcher is passed to returned one and func is not called,
+    // continuation is started by completion callback, so no thread waits for this watcher
+    template <typename Func>
+    FutureWatcherPtr<std::invoke_result_t<std::decay_t<Func>, const Result&>> then(Func&& func, RunPolicy policy = RunPolicy::ThreadPool) {
+        using NextResult = std::invoke_result_t<std::decay_t<Func>, const Result&>;
+
+        auto self = std::static_pointer_cast<FutureWatcher>(this->shared_from_this());
+        auto next = std::make_shared<FutureWatcher<NextResult>>(policy);
+        next->state_ = WatcherState::Running;
+
+        Task continuation([self, next, policy, func = std::forward<Func>(func)]() mutable {
+            if (!self->result_) {
+                next->setFailed(*self);
+                return;
+            }
+
+            next->start(policy, [self, next, func = std::move(func)]() mutable {
+                next->invoke(std::move(func), std::forward_as_tuple(std::as_const(*self->result_)));
+            });
+        });
+
+        if (!Super::addCompletionCallback(std::move(continuation))) {
+            continuation();
+        }
+
+        return next;
+    }
+
 protected:
     using Super = details::FutureBase<Result>;
     friend class Concurrent;
+    friend class details::WatcherAwaiter<Result>;
+    friend class details::WatcherCombinators;
 
-    void watch() {
-        auto closure = [=] {
-            try {
-                Result result = Super::future_.get();
-
-                auto lambda = [this, res = std::move(result)]() {
-                    Super::await(finished);
-                    emit finished(std::move(res));
+    template <typename T>
+    friend class FutureWatcher;
 
-                    Super::setCompletedState();
-                };
+    // calls function at current thread and completes watcher
+    template <typename Func, typename Tuple>
+    void invoke(Func&& func, Tuple&& args) {
+        try {
+            setResult(std::apply(std::forward<Func>(func), std::forward<Tuple>(args)));
+        }
+        catch (const CancelledException&) {
+            setCancelled();
+        }
+        catch (const std::exception& e) {
+            setFailed(std::current_exception(), e.what());
+        }
+        catch (...) {
+            setFailed(std::current_exception(), "unknown exception");
+        }
+    }
 
-                lambda();
+    void watch() {
+        auto closure = [this] {
+            try {
+                setResult(Super::future_.get());
             }
-            catch (std::exception& e) {
-                Super::await(failed);
-
-                cslog() << "Concurrent execution with " << typeid(Result).name() << " failed, " << e.what();
-                emit failed();
+            catch (const std::exception& e) {
+                setFailed(std::current_exception(), e.what());
+            }
+            catch (...) {
+                setFailed(std::current_exception(), "unknown exception");
             }
         };
 
         Super::state_ = WatcherState::Running;
-        details::Worker::execute(Super::policy_, std::move(closure));
+        details::Worker::execute(Super::policy_, Task(std::move(closure)));
+    }
+
+    void setResult(Result&& result) {
+        result_.emplace(std::move(result));
+        Super::setCompletedState();
+    }
+
+    void setFailed(std::exception_ptr exception, const char* message) {
+        error_ = std::move(exception);
+        cslog() << "Concurrent execution with " << typeid(Result).name() << " failed, " << message;
+        Super::setCompletedState();
+    }
+
+    // task was cancelled before start or stopped by CancelledException
+    void setCancelled() {
+        error_ = std::make_exception_ptr(CancelledException());
+        cancelled_ = true;
+        Super::setCompletedState();
+    }
+
+    // passes failure or cancellation of other completed watcher without logging it again
+    template <typename T>
+    void setFailed(const FutureWatcher<T>& watcher) {
+        error_ = watcher.error_;
+        cancelled_ = watcher.cancelled_;
+        Super::setCompletedState();
+    }
+
+    // executes closure which completes watcher by policy, watcher fails if policy could not take it
+    template <typename Func>
+    void start(RunPolicy policy, Func&& closure) {
+        try {
+            details::Worker::execute(policy, Task(std::forward<Func>(closure)));
+        }
+        catch (const std::exception& e) {
+            setFailed(std::current_exception(), e.what());
+        }
+    }
+
+    const details::SignalConnection* resultSignal() const override {
+        if (result_) {
+            return &finished;
+        }
+
+        return cancelled_ ? &cancelled : &failed;
+    }
+
+    void emitResult() override {
+        if (result_) {
+            emit finished(*result_);
+        }
+        else if (cancelled_) {
+            emit cancelled();
+        }
+        else {
+            emit failed();
+        }
     }
 
 public signals:
     FinishSignal finished;
     FailedSignal failed;
+    CancelledSignal cancelled;
+
+private:
+    std::optional<Result> result_;
+    std::exception_ptr error_;
+    bool cancelled_ = false;
 };
 
 template <>
 class FutureWatcher<void> : public details::FutureBase<void> {
-    using FinishSignal = cs::Signal<void()>;
-    using FailedSignal = cs::Signal<void()>;
+    using FinishSignal = details::WatcherSignal<void()>;
+    using FailedSignal = details::WatcherSignal<void()>;
+    using CancelledSignal = details::WatcherSignal<void()>;
 
 public:
     explicit FutureWatcher(RunPolicy policy, Future<void>&& future):
-        details::FutureBase<void>(policy, std::move(future)) {
+        details::FutureBase<void>(policy, std::move(future)), finished(this), failed(this), cancelled(this) {
         watch();
     }
 
-    FutureWatcher() = default;
+    // watcher which result is set by running task
+    explicit FutureWatcher(RunPolicy policy):
+        details::FutureBase<void>(policy), finished(this), failed(this), cancelled(this) {
+    }
+
+    FutureWatcher():
+        finished(this), failed(this), cancelled(this) {
+    }
+
     ~FutureWatcher() = default;
-    FutureWatcher(FutureWatcher&& watcher) = default;
+
+    FutureWatcher(FutureWatcher&& watcher):
+        details::FutureBase<void>(std::move(watcher)),
+        finished(std::move(watcher.finished), this),
+        failed(std::move(watcher.failed), this),
+        cancelled(std::move(watcher.cancelled), this),
+        succeeded_(watcher.succeeded_),
+        error_(std::move(watcher.error_)),
+        cancelled_(watcher.cancelled_) {
+    }
 
     FutureWatcher& operator=(FutureWatcher&& watcher) noexcept = delete;
 
+    // runs func by policy after watcher is finished, returns watcher of func result,
+    // failure or cancellation of this watcher is passed to returned one and func is not called
+    template <typename Func>
+    FutureWatcherPtr<std::invoke_result_t<std::decay_t<Func>>> then(Func&& func, RunPolicy policy = RunPolicy::ThreadPool) {
+        using NextResult = std::invoke_result_t<std::decay_t<Func>>;
+
+        auto self = std::static_pointer_cast<FutureWatcher>(this->shared_from_this());
+        auto next = std::make_shared<FutureWatcher<NextResult>>(policy);
+        next->state_ = WatcherState::Running;
+
+        Task continuation([self, next, policy, func = std::forward<Func>(func)]() mutable {
+            if (!self->succeeded_) {
+                next->setFailed(*self);
+                return;
+            }
+
+            next->start(policy, [next, func = std::move(func)]() mutable {
+                next->invoke(std::move(func), std::make_tuple());
+            });
+        });
+
+        if (!Super::addCompletionCallback(std::move(continuation))) {
+            continuation();
+        }
+
+        return next;
+    }
+
 protected:
     using Super = FutureBase<void>;
     friend class Concurrent;
+    friend class details::WatcherAwaiter<void>;
+    friend class details::WatcherCombinators;
+
+    template <typename T>
+    friend class FutureWatcher;
+
+    // calls function at current thread and completes watcher
+    template <typename Func, typename Tuple>
+    void invoke(Func&& func, Tuple&& args) {
+        try {
+            std::apply(std::forward<Func>(func), std::forward<Tuple>(args));
+            setResult();
+        }
+        catch (const CancelledException&) {
+            setCancelled();
+        }
+        catch (const std::exception& e) {
+            setFailed(std::current_exception(), e.what());
+        }
+        catch (...) {
+            setFailed(std::current_exception(), "unknown exception");
+        }
+    }
 
     void watch() {
-        auto closure = [=] {
+        auto closure = [this] {
             try {
                 Super::future_.get();
-
-                auto signal = [=] {
-                    Super::await(finished);
-                    emit finished();
-
-                    Super::setCompletedState();
-                };
-
-                signal();
+                setResult();
             }
-            catch (std::exception& e) {
-                Super::await(failed);
-
-                cslog() << "Concurrent execution with void result failed, " << e.what();
-                emit failed();
+            catch (const std::exception& e) {
+                setFailed(std::current_exception(), e.what());
+            }
+            catch (...) {
+                setFailed(std::current_exception(), "unknown exception");
             }
         };
 
         Super::state_ = WatcherState::Running;
-        details::Worker::execute(Super::policy_, std::move(closure));
+        details::Worker::execute(Super::policy_, Task(std::move(closure)));
+    }
+
+    void setResult() {
+        succeeded_ = true;
+        Super::setCompletedState();
+    }
+
+    void setFailed(std::exception_ptr exception, const char* message) {
+        error_ = std::move(exception);
+        cslog() << "Concurrent execution with void result failed, " << message;
+        Super::setCompletedState();
+    }
+
+    // task was cancelled before start or stopped by CancelledException
+    void setCancelled() {
+        error_ = std::make_exception_ptr(CancelledException());
+        cancelled_ = true;
+        Super::setCompletedState();
+    }
+
+    // passes failure or cancellation of other completed watcher without logging it again
+    template <typename T>
+    void setFailed(const FutureWatcher<T>& watcher) {
+        error_ = watcher.error_;
+        cancelled_ = watcher.cancelled_;
+        Super::setCompletedState();
+    }
+
+    // executes closure which completes watcher by policy, watcher fails if policy could not take it
+    template <typename Func>
+    void start(RunPolicy policy, Func&& closure) {
+        try {
+            details::Worker::execute(policy, Task(std::forward<Func>(closure)));
+        }
+        catch (const std::exception& e) {
+            setFailed(std::current_exception(), e.what());
+        }
+    }
+
+    const details::SignalConnection* resultSignal() const override {
+        if (succeeded_) {
+            return &finished;
+        }
+
+        return cancelled_ ? &cancelled : &failed;
+    }
+
+    void emitResult() override {
+        if (succeeded_) {
+            emit finished();
+        }
+        else if (cancelled_) {
+            emit cancelled();
+        }
+        else {
+            emit failed();
+        }
     }
 
 public signals:
     FinishSignal finished;
     FailedSignal failed;
-};
+    CancelledSignal cancelled;
 
-// safe pointer to watcher
-template <typename T>
-using FutureWatcherPtr = std::shared_ptr<FutureWatcher<T>>;
+private:
+    bool succeeded_ = false;
+    std::exception_ptr error_;
+    bool cancelled_ = false;
+};
 }
 
 #endif // CS_FUTURE_HPP
@@ -0,0 +1,84 @@
+#ifndef CS_LATCH_HPP
+#define CS_LATCH_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <cs/utils/details/futex.hpp>
+
+namespace cs {
+// single use countdown, threads sleep at futex until counter reaches zero,
+// only the last count down enters kernel and only if somebody waits
+class Latch {
+public:
+    explicit Latch(uint32_t count) noexcept:
+        counter_(count) {}
+
+    Latch(const Latch&) = delete;
+    Latch& operator=(const Latch&) = delete;
+
+    // warn: counter should not be decremented below zero
+    void countDown(uint32_t count = 1) {
+        if (counter_.fetch_sub(count, std::memory_order_seq_cst) == count && waiters_.load(std::memory_order_seq_cst) != 0) {
+            details::futexWake(counter_, details::futexWakeAll);
+        }
+    }
+
+    // returns true if counter reached zero
+    bool tryWait() const noexcept {
+        return counter_.load(std::memory_order_acquire) == 0;
+    }
+
+    // blocks until counter reaches zero
+    void wait() {
+        if (tryWait()) {
+            return;
+        }
+
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+
+        for (uint32_t counter = counter_.load(std::memory_order_seq_cst); counter != 0; counter = counter_.load(std::memory_order_seq_cst)) {
+            details::futexWait(counter_, counter);
+        }
+
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // returns false if timeout is expired before counter reaches zero
+    template <typename Rep, typename Period>
+    bool waitFor(const std::chrono::duration<Rep, Period>& timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+
+        if (tryWait()) {
+            return true;
+        }
+
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+
+        for (uint32_t counter = counter_.load(std::memory_order_seq_cst); counter != 0; counter = counter_.load(std::memory_order_seq_cst)) {
+            const auto left = details::futexTimeout(deadline);
+
+            if (left.count() == 0) {
+                break;
+            }
+
+            details::futexWait(counter_, counter, left);
+        }
+
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return tryWait();
+    }
+
+    void arriveAndWait(uint32_t count = 1) {
+        countDown(count);
+        wait();
+    }
+
+private:
+    details::FutexWord counter_;
+    std::atomic<uint32_t> waiters_ = { 0 };
+};
+}
+
+#endif // CS_LATCH_HPP
@@ -0,0 +1,337 @@
+#ifndef CS_PARALLEL_HPP
+#define CS_PARALLEL_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <iterator>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace cs {
+namespace details {
+// chunks count per worker at auto grain, more chunks give better balance of uneven work
+constexpr size_t chunksPerWorker = 8;
+
+// ranges smaller than this are sorted without pool
+constexpr size_t sequentialSortSize = 4096;
+
+inline size_t autoGrain(size_t size, const ThreadPool& pool) {
+    const size_t chunks = std::max<size_t>(pool.size(), 1) * chunksPerWorker;
+    return std::max<size_t>(size / chunks, 1);
+}
+
+// shared state of one parallel call, chunks are claimed dynamically by caller and pool workers,
+// so caller never waits for chunk which is not running and there is no pool starvation
+class ChunksState {
+public:
+    template <typename Func>
+    ChunksState(size_t count, Func& func):
+        count_(count),
+        func_(static_cast<void*>(&func)),
+        invoke_([](void* func, size_t index) { (*static_cast<Func*>(func))(index); }) {}
+
+    // claims and runs chunks until no one left
+    void run() {
+        for (;;) {
+            const size_t index = next_.fetch_add(1, std::memory_order_relaxed);
+
+            if (index >= count_) {
+                return;
+            }
+
+            if (!failed_.load(std::memory_order_relaxed)) {
+                try {
+                    invoke_(func_, index);
+                }
+                catch (...) {
+                    std::lock_guard lock(mutex_);
+
+                    if (!exception_) {
+                        exception_ = std::current_exception();
+                    }
+
+                    failed_.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            if (done_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_) {
+                std::lock_guard lock(mutex_);
+                notifier_.notify_all();
+            }
+        }
+    }
+
+    // waits for all chunks and rethrows first chunk exception
+    void wait() {
+        std::unique_lock lock(mutex_);
+
+        notifier_.wait(lock, [this] {
+            return done_.load(std::memory_order_acquire) == count_;
+        });
+
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+private:
+    const size_t count_;
+    void* const func_;
+    void (*const invoke_)(void*, size_t);
+
+    std::atomic<size_t> next_ = { 0 };
+    std::atomic<size_t> done_ = { 0 };
+    std::atomic<bool> failed_ = { false };
+
+    std::mutex mutex_;
+    std::condition_variable notifier_;
+    std::exception_ptr exception_;
+};
+
+// calls func(chunkIndex) for every chunk at pool and caller thread, blocks until all chunks finished
+template <typename Func>
+void parallelChunks(ThreadPool& pool, size_t chunksCount, Func&& func) {
+    if (chunksCount == 0) {
+        return;
+    }
+
+    if (chunksCount == 1 || pool.size() == 0) {
+        for (size_t i = 0; i < chunksCount; ++i) {
+            func(i);
+        }
+
+        return;
+    }
+
+    auto state = std::make_shared<ChunksState>(chunksCount, func);
+    const size_t helpers = std::min(pool.size(), chunksCount - 1);
+
+    for (size_t i = 0; i < helpers; ++i) {
+        pool.enqueue([state] {
+            state->run();
+        });
+    }
+
+    state->run();
+    state->wait();
+}
+
+template <typename Index>
+size_t chunksCount(Index size, size_t grain) {
+    return (static_cast<size_t>(size) + grain - 1) / grain;
+}
+}
+
+// calls func(index) for every index at [first, last) range,
+// range is split to chunks of grain size, zero grain means auto grain size
+template <typename Index, typename Func, typename = std::enable_if_t<std::is_integral_v<Index>>>
+void parallelFor(ThreadPool& pool, Index first, Index last, size_t grain, Func&& func) {
+    if (last <= first) {
+        return;
+    }
+
+    const auto size = static_cast<size_t>(last - first);
+
+    if (grain == 0) {
+        grain = details::autoGrain(size, pool);
+    }
+
+    auto chunk = [&](size_t index) {
+        const size_t begin = index * grain;
+        const size_t end = std::min(begin + grain, size);
+
+        for (size_t i = begin; i < end; ++i) {
+            func(static_cast<Index>(first + static_cast<Index>(i)));
+        }
+    };
+
+    details::parallelChunks(pool, details::chunksCount(size, grain), chunk);
+}
+
+template <typename Index, typename Func, typename = std::enable_if_t<std::is_integral_v<Index>>>
+void parallelFor(Index first, Index last, size_t grain, Func&& func) {
+    cs::parallelFor(ThreadPool::instance(), first, last, grain, std::forward<Func>(func));
+}
+
+template <typename Index, typename Func, typename = std::enable_if_t<std::is_integral_v<Index>>>
+void parallelFor(Index first, Index last, Func&& func) {
+    cs::parallelFor(ThreadPool::instance(), first, last, 0, std::forward<Func>(func));
+}
+
+// writes op(*it) for every element of [first, last) to output range, returns output end
+template <typename InputIterator, typename OutputIterator, typename UnaryOperation>
+OutputIterator parallelTransform(ThreadPool& pool, InputIterator first, InputIterator last, OutputIterator output, UnaryOperation op) {
+    const auto size = std::distance(first, last);
+
+    cs::parallelFor(pool, decltype(size){0}, size, 0, [&](auto index) {
+        *(output + index) = op(*(first + index));
+    });
+
+    return output + size;
+}
+
+template <typename InputIterator, typename OutputIterator, typename UnaryOperation>
+OutputIterator parallelTransform(InputIterator first, InputIterator last, OutputIterator output, UnaryOperation op) {
+    return cs::parallelTransform(ThreadPool::instance(), first, last, output, std::move(op));
+}
+
+// reduces [first, last) range with associative operation
+template <typename Iterator, typename T, typename BinaryOperation = std::plus<>>
+T parallelReduce(ThreadPool& pool, Iterator first, Iterator last, T init, BinaryOperation op = {}) {
+    const auto size = static_cast<size_t>(std::distance(first, last));
+
+    if (size == 0) {
+        return init;
+    }
+
+    const size_t grain = details::autoGrain(size, pool);
+    const size_t chunks = details::chunksCount(size, grain);
+
+    std::vector<std::optional<T>> partials(chunks);
+
+    details::parallelChunks(pool, chunks, [&](size_t index) {
+        auto begin = first + static_cast<std::ptrdiff_t>(index * grain);
+        auto end = first + static_cast<std::ptrdiff_t>(std::min((index + 1) * grain, size));
+
+        T value = *begin;
+
+        for (++begin; begin != end; ++begin) {
+            value = op(std::move(value), *begin);
+        }
+
+        partials[index] = std::move(value);
+    });
+
+    for (auto& partial : partials) {
+        init = op(std::move(init), std::move(*partial));
+    }
+
+    return init;
+}
+
+template <typename Iterator, typename T, typename BinaryOperation = std::plus<>>
+T parallelReduce(Iterator first, Iterator last, T init, BinaryOperation op = {}) {
+    return cs::parallelReduce(ThreadPool::instance(), first, last, std::move(init), std::move(op));
+}
+
+// writes inclusive scan of [first, last) range to output range, returns output end
+template <typename InputIterator, typename OutputIterator, typename BinaryOperation = std::plus<>>
+OutputIterator parallelScan(ThreadPool& pool, InputIterator first, InputIterator last, OutputIterator output, BinaryOperation op = {}) {
+    using ValueType = typename std::iterator_traits<InputIterator>::value_type;
+
+    const auto size = static_cast<size_t>(std::distance(first, last));
+
+    if (size == 0) {
+        return output;
+    }
+
+    const size_t grain = details::autoGrain(size, pool);
+    const size_t chunks = details::chunksCount(size, grain);
+
+    auto bounds = [&](size_t index) {
+        return std::make_pair(static_cast<std::ptrdiff_t>(index * grain), static_cast<std::ptrdiff_t>(std::min((index + 1) * grain, size)));
+    };
+
+    // first pass reduces every chunk
+    std::vector<std::optional<ValueType>> offsets(chunks);
+
+    details::parallelChunks(pool, chunks, [&](size_t index) {
+        const auto [begin, end] = bounds(index);
+        ValueType value = *(first + begin);
+
+        for (auto i = begin + 1; i < end; ++i) {
+            value = op(std::move(value), *(first + i));
+        }
+
+        offsets[index] = std::move(value);
+    });
+
+    // exclusive scan of chunk sums gives every chunk its initial value
+    std::optional<ValueType> carry;
+
+    for (auto& offset : offsets) {
+        auto sum = std::move(offset);
+        offset = carry;
+
+        if (carry) {
+            carry = op(std::move(*carry), std::move(*sum));
+        }
+        else {
+            carry = std::move(sum);
+        }
+    }
+
+    // second pass scans every chunk from its offset
+    details::parallelChunks(pool, chunks, [&](size_t index) {
+        const auto [begin, end] = bounds(index);
+        ValueType value = *(first + begin);
+
+        if (offsets[index]) {
+            value = op(*offsets[index], std::move(value));
+        }
+
+        *(output + begin) = value;
+
+        for (auto i = begin + 1; i < end; ++i) {
+            value = op(std::move(value), *(first + i));
+            *(output + i) = value;
+        }
+    });
+
+    return output + static_cast<std::ptrdiff_t>(size);
+}
+
+template <typename InputIterator, typename OutputIterator, typename BinaryOperation = std::plus<>>
+OutputIterator parallelScan(InputIterator first, InputIterator last, OutputIterator output, BinaryOperation op = {}) {
+    return cs::parallelScan(ThreadPool::instance(), first, last, output, std::move(op));
+}
+
+// sorts chunks in parallel and merges them pairwise
+template <typename Iterator, typename Compare = std::less<>>
+void parallelSort(ThreadPool& pool, Iterator first, Iterator last, Compare comp = {}) {
+    const auto size = static_cast<size_t>(std::distance(first, last));
+
+    if (size <= details::sequentialSortSize || pool.size() < 2) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    size_t chunks = 1;
+
+    while (chunks < pool.size() * 2) {
+        chunks <<= 1;
+    }
+
+    size_t grain = (size + chunks - 1) / chunks;
+
+    auto at = [&](size_t offset) {
+        return first + static_cast<std::ptrdiff_t>(std::min(offset, size));
+    };
+
+    details::parallelChunks(pool, chunks, [&](size_t index) {
+        std::sort(at(index * grain), at((index + 1) * grain), comp);
+    });
+
+    for (; chunks > 1; chunks >>= 1, grain <<= 1) {
+        details::parallelChunks(pool, chunks / 2, [&](size_t index) {
+            const size_t begin = index * 2 * grain;
+            std::inplace_merge(at(begin), at(begin + grain), at(begin + 2 * grain), comp);
+        });
+    }
+}
+
+template <typename Iterator, typename Compare = std::less<>>
+void parallelSort(Iterator first, Iterator last, Compare comp = {}) {
+    cs::parallelSort(ThreadPool::instance(), first, last, std::move(comp));
+}
+}
+
+#endif // CS_PARALLEL_HPP
@@ -0,0 +1,478 @@
+#ifndef CS_PIPELINE_HPP
+#define CS_PIPELINE_HPP
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <typeindex>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+
+#include <cs/containers/mpmc_queue.hpp>
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace cs {
+// defines how pipeline stage processes tokens
+enum class StageMode : unsigned char {
+    // one token at a time in input order
+    Serial,
+
+    // any tokens at once
+    Parallel
+};
+
+// lets pipeline input stage finish the stream
+class FlowControl {
+public:
+    // value returned by input stage after stop is dropped
+    void stop() noexcept {
+        stopped_ = true;
+    }
+
+    bool isStopped() const noexcept {
+        return stopped_;
+    }
+
+private:
+    bool stopped_ = false;
+};
+
+namespace details {
+// move only value of token passed between stages, types of adjacent stages are checked
+// when stages are added, so value is taken without type check, small values are stored inline
+class StageValue {
+public:
+    StageValue() = default;
+
+    ~StageValue() {
+        reset();
+    }
+
+    StageValue(const StageValue&) = delete;
+    StageValue& operator=(const StageValue&) = delete;
+
+    template <typename T, typename... Args>
+    void emplace(Args&&... args) {
+        reset();
+
+        if constexpr (isInline<T>()) {
+            value_ = new (storage_) T(std::forward<Args>(args)...);
+            destroy_ = [](void* value) noexcept {
+                static_cast<T*>(value)->~T();
+            };
+        }
+        else {
+            value_ = new T(std::forward<Args>(args)...);
+            destroy_ = [](void* value) noexcept {
+                delete static_cast<T*>(value);
+            };
+        }
+    }
+
+    template <typename T>
+    T& get() noexcept {
+        return *static_cast<T*>(value_);
+    }
+
+    void reset() noexcept {
+        if (destroy_) {
+            std::exchange(destroy_, nullptr)(value_);
+            value_ = nullptr;
+        }
+    }
+
+private:
+    static constexpr size_t inlineSize = 4 * sizeof(void*);
+
+    template <typename T>
+    static constexpr bool isInline() noexcept {
+        return sizeof(T) <= inlineSize && alignof(T) <= alignof(std::max_align_t);
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[inlineSize];
+    void* value_ = nullptr;
+    void (*destroy_)(void*) noexcept = nullptr;
+};
+}
+
+class Pipeline;
+
+// stages chain of pipeline with known output type, next stage input is checked at compile time
+template <typename Out>
+class PipelineStages {
+public:
+    explicit PipelineStages(Pipeline& pipeline) noexcept:
+        pipeline_(pipeline) {}
+
+    // adds next stage, In should be Out of previous stage
+    template <typename In, typename Next, typename Func>
+    PipelineStages<Next> add(StageMode mode, Func&& func);
+
+    Pipeline& pipeline() const noexcept {
+        return pipeline_;
+    }
+
+private:
+    Pipeline& pipeline_;
+};
+
+// chain of serial and parallel stages running at thread pool, every value produced by input stage
+// travels through all stages as a token, at most maxTokens tokens are in flight, so memory is bounded
+// and input waits for free token, serial stages get tokens in input order
+// warn: pipeline should not be changed or run concurrently while it is running
+class Pipeline {
+public:
+    explicit Pipeline(size_t maxTokens, ThreadPool& pool = ThreadPool::instance()):
+        pool_(pool), maxTokens_(std::max<size_t>(maxTokens, 1)),
+        tokens_(maxTokens_), freeTokens_(maxTokens_) {}
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // adds stage, In of first stage is void and stage is called with FlowControl,
+    // In of next stage should be Out of previous one, Out of last stage is usually void,
+    // stages chained by returned value are checked at compile time, separate calls at run time
+    template <typename In, typename Out, typename Func>
+    PipelineStages<Out> add(StageMode mode, Func&& func) {
+        static_assert(!std::is_reference_v<In> && !std::is_reference_v<Out>, "Pipeline stage types should be values");
+        static_assert(std::is_void_v<Out> || std::is_move_constructible_v<Out>, "Pipeline stage output should be movable");
+
+        if (std::type_index(typeid(In)) != outType_) {
+            throw std::logic_error("Pipeline stage input type does not match previous stage output");
+        }
+
+        if constexpr (std::is_void_v<In>) {
+            static_assert(std::is_invocable_r_v<Out, std::decay_t<Func>&, FlowControl&>, "Pipeline input stage should be called with FlowControl and return Out");
+
+            if (mode != StageMode::Serial) {
+                throw std::logic_error("Pipeline input stage should be serial");
+            }
+
+            input_ = std::make_unique<InputStage<Out, std::decay_t<Func>>>(std::forward<Func>(func));
+        }
+        else {
+            static_assert(std::is_invocable_r_v<Out, std::decay_t<Func>&, In&&>, "Pipeline stage should be called with In and return Out");
+            stages_.push_back(std::make_unique<TypedStage<In, Out, std::decay_t<Func>>>(mode, std::forward<Func>(func), maxTokens_));
+        }
+
+        outType_ = std::type_index(typeid(Out));
+        return PipelineStages<Out>(*this);
+    }
+
+    // runs input stage until it stops flow and waits for all tokens running queued pool tasks meanwhile,
+    // rethrows first stage exception, input is stopped and bodies of tokens in flight are skipped then
+    void run() {
+        if (!input_) {
+            throw std::logic_error("Pipeline has no input stage");
+        }
+
+        reset();
+
+        pump();
+
+        pool_.helpUntil([this] {
+            return pending_.load(std::memory_order_acquire) == 0;
+        });
+
+        if (exception_) {
+            std::rethrow_exception(std::exchange(exception_, nullptr));
+        }
+    }
+
+    size_t maxTokens() const noexcept {
+        return maxTokens_;
+    }
+
+    // returns stages count including input
+    size_t size() const noexcept {
+        return stages_.size() + (input_ ? 1 : 0);
+    }
+
+private:
+    constexpr static size_t npos = static_cast<size_t>(-1);
+
+    struct Token {
+        details::StageValue value;
+        uint64_t sequence = 0;
+    };
+
+    struct Input {
+        virtual ~Input() = default;
+        virtual void call(details::StageValue& value, FlowControl& flow) = 0;
+    };
+
+    template <typename Out, typename Func>
+    struct InputStage final : Input {
+        template <typename F>
+        explicit InputStage(F&& stageFunc):
+            func(std::forward<F>(stageFunc)) {}
+
+        void call(details::StageValue& value, FlowControl& flow) override {
+            if constexpr (std::is_void_v<Out>) {
+                func(flow);
+            }
+            else {
+                value.emplace<Out>(func(flow));
+            }
+        }
+
+        Func func;
+    };
+
+    // serial stage keeps tokens which came out of order, sequences in flight differ less than maxTokens,
+    // so token waits at slot of its sequence modulo maxTokens
+    struct Stage {
+        Stage(StageMode stageMode, size_t maxTokens):
+            mode(stageMode), waiting(maxTokens, npos) {}
+
+        virtual ~Stage() = default;
+
+        // replaces input value of token by output value
+        virtual void call(details::StageValue& value) = 0;
+
+        StageMode mode;
+
+        std::mutex mutex;
+        uint64_t next = 0;
+        std::vector<size_t> waiting;
+    };
+
+    template <typename In, typename Out, typename Func>
+    struct TypedStage final : Stage {
+        template <typename F>
+        TypedStage(StageMode stageMode, F&& stageFunc, size_t maxTokens):
+            Stage(stageMode, maxTokens), func(std::forward<F>(stageFunc)) {}
+
+        void call(details::StageValue& value) override {
+            if constexpr (std::is_void_v<Out>) {
+                func(std::move(value.get<In>()));
+                value.reset();
+            }
+            else {
+                value.emplace<Out>(func(std::move(value.get<In>())));
+            }
+        }
+
+        Func func;
+    };
+
+    void reset() {
+        for (auto& stage : stages_) {
+            stage->next = 0;
+            std::fill(stage->waiting.begin(), stage->waiting.end(), npos);
+        }
+
+        size_t index = 0;
+
+        while (freeTokens_.tryPop(index)) {}
+
+        for (size_t i = 0; i < maxTokens_; ++i) {
+            freeTokens_.tryPush(i);
+        }
+
+        nextSequence_ = 0;
+        stopped_.store(false, std::memory_order_relaxed);
+        failed_.store(false, std::memory_order_relaxed);
+        exception_ = nullptr;
+
+        // open input is counted as pending until flow is stopped
+        pending_.store(1, std::memory_order_release);
+    }
+
+    // runs input stage while free tokens exist, only one thread runs input at a time,
+    // produced tokens continue at pool, so input keeps going
+    void pump() {
+        for (;;) {
+            if (inputBusy_.exchange(true, std::memory_order_seq_cst)) {
+                return;
+            }
+
+            size_t index = 0;
+
+            while (!stopped_.load(std::memory_order_acquire) && freeTokens_.tryPop(index)) {
+                if (!produce(index)) {
+                    return;
+                }
+            }
+
+            inputBusy_.store(false, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // token released while input was busy could be missed by its releaser
+            if (stopped_.load(std::memory_order_acquire) || freeTokens_.isEmpty()) {
+                return;
+            }
+        }
+    }
+
+    // runs input stage with free token, returns false if flow is stopped
+    bool produce(size_t index) {
+        auto& token = tokens_[index];
+        FlowControl flow;
+
+        if (!failed_.load(std::memory_order_acquire)) {
+            try {
+                input_->call(token.value, flow);
+            }
+            catch (...) {
+                fail(std::current_exception());
+            }
+        }
+
+        if (flow.isStopped() || failed_.load(std::memory_order_acquire)) {
+            token.value.reset();
+            freeTokens_.tryPush(index);
+
+            stopped_.store(true, std::memory_order_release);
+            inputBusy_.store(false, std::memory_order_release);
+
+            finish();
+            return false;
+        }
+
+        token.sequence = nextSequence_++;
+        pending_.fetch_add(1, std::memory_order_relaxed);
+
+        try {
+            pool_.enqueue([this, index] {
+                process(index, 0);
+            });
+        }
+        catch (...) {
+            fail(std::current_exception());
+            process(index, 0);
+        }
+
+        return true;
+    }
+
+    // moves token through stages starting from stage index
+    void process(size_t index, size_t stageIndex) {
+        auto& token = tokens_[index];
+
+        for (; stageIndex < stages_.size(); ++stageIndex) {
+            auto& stage = *stages_[stageIndex];
+
+            if (stage.mode == StageMode::Parallel) {
+                call(stage, token);
+                continue;
+            }
+
+            // token is resumed by thread which releases previous sequence
+            if (!enter(stage, token.sequence, index)) {
+                return;
+            }
+
+            call(stage, token);
+
+            const size_t ready = leave(stage);
+
+            if (ready != npos) {
+                resume(ready, stageIndex);
+            }
+        }
+
+        token.value.reset();
+        freeTokens_.tryPush(index);
+
+        pump();
+        finish();
+    }
+
+    void call(Stage& stage, Token& token) {
+        if (failed_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        try {
+            stage.call(token.value);
+        }
+        catch (...) {
+            fail(std::current_exception());
+        }
+    }
+
+    // returns true if token is next for serial stage, otherwise token waits
+    bool enter(Stage& stage, uint64_t sequence, size_t index) {
+        std::lock_guard lock(stage.mutex);
+
+        if (stage.next == sequence) {
+            return true;
+        }
+
+        stage.waiting[sequence % maxTokens_] = index;
+        return false;
+    }
+
+    // passes stage to next sequence, returns index of waiting token with it
+    size_t leave(Stage& stage) {
+        std::lock_guard lock(stage.mutex);
+
+        const auto slot = ++stage.next % maxTokens_;
+        return std::exchange(stage.waiting[slot], npos);
+    }
+
+    void resume(size_t index, size_t stageIndex) {
+        try {
+            pool_.enqueue([this, index, stageIndex] {
+                process(index, stageIndex);
+            });
+        }
+        catch (...) {
+            fail(std::current_exception());
+            process(index, stageIndex);
+        }
+    }
+
+    void fail(std::exception_ptr exception) noexcept {
+        if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+            exception_ = std::move(exception);
+        }
+    }
+
+    void finish() {
+        // pipeline could be destroyed by run caller right after last decrement
+        auto& pool = pool_;
+
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            pool.notifyWaiters();
+        }
+    }
+
+    ThreadPool& pool_;
+    const size_t maxTokens_;
+
+    std::unique_ptr<Input> input_;
+    std::vector<std::unique_ptr<Stage>> stages_;
+    std::type_index outType_ = std::type_index(typeid(void));
+
+    std::vector<Token> tokens_;
+    MpmcQueue<size_t> freeTokens_;
+
+    // written only by thread which runs input
+    uint64_t nextSequence_ = 0;
+
+    std::atomic<bool> inputBusy_ = { false };
+    std::atomic<bool> stopped_ = { false };
+    std::atomic<size_t> pending_ = { 0 };
+
+    std::atomic<bool> failed_ = { false };
+    std::exception_ptr exception_;
+};
+
+template <typename Out>
+template <typename In, typename Next, typename Func>
+inline PipelineStages<Next> PipelineStages<Out>::add(StageMode mode, Func&& func) {
+    static_assert(std::is_same_v<In, Out>, "Pipeline stage input type does not match previous stage output");
+    return pipeline_.add<In, Next>(mode, std::forward<Func>(func));
+}
+}
+
+#endif // CS_PIPELINE_HPP
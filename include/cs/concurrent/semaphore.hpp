@@ -0,0 +1,102 @@
+#ifndef CS_SEMAPHORE_HPP
+#define CS_SEMAPHORE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <cs/utils/details/futex.hpp>
+
+namespace cs {
+// counting semaphore, acquire takes one permit and sleeps at futex while there are none,
+// release does not enter kernel while nobody waits
+class Semaphore {
+public:
+    explicit Semaphore(uint32_t permits = 0) noexcept:
+        permits_(permits) {}
+
+    Semaphore(const Semaphore&) = delete;
+    Semaphore& operator=(const Semaphore&) = delete;
+
+    // returns permits and wakes up to count waiting threads
+    void release(uint32_t count = 1) {
+        if (count == 0) {
+            return;
+        }
+
+        permits_.fetch_add(count, std::memory_order_seq_cst);
+
+        if (waiters_.load(std::memory_order_seq_cst) != 0) {
+            details::futexWake(permits_, count);
+        }
+    }
+
+    // returns false if there are no permits
+    bool tryAcquire() noexcept {
+        uint32_t permits = permits_.load(std::memory_order_relaxed);
+
+        while (permits != 0) {
+            if (permits_.compare_exchange_weak(permits, permits - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // blocks until permit is taken
+    void acquire() {
+        if (tryAcquire()) {
+            return;
+        }
+
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+
+        while (!tryAcquire()) {
+            details::futexWait(permits_, 0);
+        }
+
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // returns false if timeout is expired before permit is taken
+    template <typename Rep, typename Period>
+    bool tryAcquireFor(const std::chrono::duration<Rep, Period>& timeout) {
+        return tryAcquireUntil(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+    }
+
+    bool tryAcquireUntil(std::chrono::steady_clock::time_point deadline) {
+        if (tryAcquire()) {
+            return true;
+        }
+
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+
+        bool acquired = false;
+
+        while (!(acquired = tryAcquire())) {
+            const auto timeout = details::futexTimeout(deadline);
+
+            if (timeout.count() == 0) {
+                break;
+            }
+
+            details::futexWait(permits_, 0, timeout);
+        }
+
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return acquired;
+    }
+
+    // approximate value, permits could be taken by other threads at any moment
+    uint32_t available() const noexcept {
+        return permits_.load(std::memory_order_relaxed);
+    }
+
+private:
+    details::FutexWord permits_;
+    std::atomic<uint32_t> waiters_ = { 0 };
+};
+}
+
+#endif // CS_SEMAPHORE_HPP
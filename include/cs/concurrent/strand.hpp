@@ -0,0 +1,180 @@
+#ifndef CS_STRAND_HPP
+#define CS_STRAND_HPP
+
+#include <tuple>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+#include <cs/utils/cache.hpp>
+#include <cs/utils/pause.hpp>
+#include <cs/logger/logger.hpp>
+#include <cs/concurrent/task.hpp>
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace cs {
+namespace details {
+// strand tasks queue and drain state, shared by strand copies, wrapped slots and scheduled drain
+class StrandState : public std::enable_shared_from_this<StrandState> {
+public:
+    // tasks are drained by portions, so one busy strand does not hold pool worker forever
+    constexpr static size_t batchSize = 64;
+
+    explicit StrandState(ThreadPool& pool):
+        pool_(pool), head_(new Node), tail_(head_.load(std::memory_order_relaxed)) {}
+
+    ~StrandState() {
+        while (tail_) {
+            delete std::exchange(tail_, tail_->next.load(std::memory_order_relaxed));
+        }
+    }
+
+    StrandState(const StrandState&) = delete;
+    StrandState& operator=(const StrandState&) = delete;
+
+    // lock free push, first task of idle strand schedules drain at pool
+    void post(Task&& task) {
+        auto node = new Node;
+        node->task = std::move(task);
+
+        auto previous = head_.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+
+        if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            schedule();
+        }
+    }
+
+    bool isCurrent() const noexcept {
+        return current_ == this;
+    }
+
+    size_t size() const noexcept {
+        return pending_.load(std::memory_order_acquire);
+    }
+
+    ThreadPool& pool() const noexcept {
+        return pool_;
+    }
+
+private:
+    struct Node {
+        Task task;
+        std::atomic<Node*> next = { nullptr };
+    };
+
+    void schedule() {
+        pool_.enqueue([self = shared_from_this()] {
+            self->drain();
+        });
+    }
+
+    // only one drain runs at a time, it is scheduled by task which makes pending count non zero
+    void drain() {
+        auto previous = std::exchange(current_, this);
+
+        for (size_t i = 0; i < batchSize; ++i) {
+            Task task = pop();
+
+            try {
+                task();
+            }
+            catch (const std::exception& exception) {
+                cslog() << "Strand task failed, " << exception.what();
+            }
+            catch (...) {
+                cslog() << "Strand task failed with unknown exception";
+            }
+
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                current_ = previous;
+                return;
+            }
+        }
+
+        current_ = previous;
+        schedule();
+    }
+
+    // single consumer pop, counted task could be not linked by producer yet
+    Task pop() {
+        Node* next = tail_->next.load(std::memory_order_acquire);
+
+        while (next == nullptr) {
+            cpuPause();
+            next = tail_->next.load(std::memory_order_acquire);
+        }
+
+        Task task = std::move(next->task);
+        delete std::exchange(tail_, next);
+
+        return task;
+    }
+
+    inline static thread_local const StrandState* current_ = nullptr;
+
+    ThreadPool& pool_;
+
+    cacheline_aligned std::atomic<Node*> head_;
+    cacheline_aligned std::atomic<size_t> pending_ = { 0 };
+
+    // consumer side, touched only by drain
+    cacheline_aligned Node* tail_;
+};
+}
+
+// serial executor, tasks posted to strand are executed at thread pool workers in posting order
+// and never concurrently, so they could use not thread safe state without mutex,
+// strand copies share one tasks queue
+class Strand {
+public:
+    explicit Strand(ThreadPool& pool = ThreadPool::instance()):
+        state_(std::make_shared<details::StrandState>(pool)) {}
+
+    // adds func to strand queue, exception of func is logged
+    template <typename Func>
+    void post(Func&& func) {
+        state_->post(Task(std::forward<Func>(func)));
+    }
+
+    // returns callable that posts func call with copied arguments to strand,
+    // use it as signal slot to deliver signal at strand,
+    // func is shared by all posted calls, so its state is changed serially
+    template <typename Func>
+    auto wrap(Func&& func) const {
+        return [state = state_, function = std::make_shared<std::decay_t<Func>>(std::forward<Func>(func))](auto&&... args) {
+            state->post(Task([function, arguments = std::make_tuple(std::decay_t<decltype(args)>(std::forward<decltype(args)>(args))...)]() mutable {
+                std::apply(*function, std::move(arguments));
+            }));
+        };
+    }
+
+    // returns true if current thread runs this strand task
+    bool isCurrent() const noexcept {
+        return state_->isCurrent();
+    }
+
+    // returns not finished tasks count
+    size_t size() const noexcept {
+        return state_->size();
+    }
+
+    ThreadPool& pool() const noexcept {
+        return state_->pool();
+    }
+
+    bool operator==(const Strand& strand) const noexcept {
+        return state_ == strand.state_;
+    }
+
+    bool operator!=(const Strand& strand) const noexcept {
+        return !(*this == strand);
+    }
+
+private:
+    std::shared_ptr<details::StrandState> state_;
+};
+}
+
+#endif // CS_STRAND_HPP
@@ -0,0 +1,178 @@
+#ifndef CS_TASK_HPP
+#define CS_TASK_HPP
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+namespace cs {
+// move only void() callable entity, small functors like lambdas or packaged tasks
+// are stored at inline buffer without heap allocation
+class Task {
+public:
+    // inline buffer size, with operations pointer the whole task takes one cache line
+    constexpr static size_t inlineSize = 48;
+
+    Task() noexcept = default;
+    Task(std::nullptr_t) noexcept {}
+
+    template <typename Func,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Func>, Task> && std::is_invocable_v<std::decay_t<Func>&>>>
+    Task(Func&& func);
+
+    Task(Task&& task) noexcept;
+    Task& operator=(Task&& task) noexcept;
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task();
+
+    // calls stored functor, throws std::bad_function_call if task is empty
+    void operator()();
+
+    // returns true if task stores functor
+    explicit operator bool() const noexcept;
+
+    // destroys stored functor
+    void reset() noexcept;
+
+    // returns true if functor is placed at inline buffer
+    bool isInline() const noexcept;
+
+    // returns true if functor of type Func would be placed at inline buffer
+    template <typename Func>
+    constexpr static bool fitsInline() noexcept;
+
+private:
+    struct Operations {
+        void (*invoke)(void* storage);
+
+        // move constructs functor from source storage to destination and destroys source one
+        void (*relocate)(void* source, void* destination) noexcept;
+        void (*destroy)(void* storage) noexcept;
+
+        bool isInline;
+    };
+
+    template <typename Func>
+    struct InlineOperations {
+        static void invoke(void* storage) {
+            std::invoke(*static_cast<Func*>(storage));
+        }
+
+        static void relocate(void* source, void* destination) noexcept {
+            auto func = static_cast<Func*>(source);
+            new (destination) Func(std::move(*func));
+            func->~Func();
+        }
+
+        static void destroy(void* storage) noexcept {
+            static_cast<Func*>(storage)->~Func();
+        }
+
+        constexpr static Operations operations = { &invoke, &relocate, &destroy, true };
+    };
+
+    template <typename Func>
+    struct HeapOperations {
+        static Func*& pointer(void* storage) noexcept {
+            return *static_cast<Func**>(storage);
+        }
+
+        static void invoke(void* storage) {
+            std::invoke(*pointer(storage));
+        }
+
+        static void relocate(void* source, void* destination) noexcept {
+            new (destination) Func*(pointer(source));
+        }
+
+        static void destroy(void* storage) noexcept {
+            delete pointer(storage);
+        }
+
+        constexpr static Operations operations = { &invoke, &relocate, &destroy, false };
+    };
+
+    alignas(std::max_align_t) unsigned char storage_[inlineSize];
+    const Operations* operations_ = nullptr;
+};
+
+template <typename Func, typename>
+inline Task::Task(Func&& func) {
+    using Type = std::decay_t<Func>;
+
+    if constexpr (std::is_pointer_v<Type> || std::is_member_pointer_v<Type>) {
+        if (func == nullptr) {
+            return;
+        }
+    }
+
+    if constexpr (fitsInline<Type>()) {
+        new (storage_) Type(std::forward<Func>(func));
+        operations_ = &InlineOperations<Type>::operations;
+    }
+    else {
+        new (storage_) Type*(new Type(std::forward<Func>(func)));
+        operations_ = &HeapOperations<Type>::operations;
+    }
+}
+
+inline Task::Task(Task&& task) noexcept {
+    if (task.operations_ != nullptr) {
+        task.operations_->relocate(task.storage_, storage_);
+        operations_ = std::exchange(task.operations_, nullptr);
+    }
+}
+
+inline Task& Task::operator=(Task&& task) noexcept {
+    if (this != &task) {
+        reset();
+
+        if (task.operations_ != nullptr) {
+            task.operations_->relocate(task.storage_, storage_);
+            operations_ = std::exchange(task.operations_, nullptr);
+        }
+    }
+
+    return *this;
+}
+
+inline Task::~Task() {
+    reset();
+}
+
+inline void Task::operator()() {
+    if (operations_ == nullptr) {
+        throw std::bad_function_call();
+    }
+
+    operations_->invoke(storage_);
+}
+
+inline Task::operator bool() const noexcept {
+    return operations_ != nullptr;
+}
+
+inline void Task::reset() noexcept {
+    if (operations_ != nullptr) {
+        operations_->destroy(storage_);
+        operations_ = nullptr;
+    }
+}
+
+inline bool Task::isInline() const noexcept {
+    return operations_ != nullptr && operations_->isInline;
+}
+
+template <typename Func>
+constexpr bool Task::fitsInline() noexcept {
+    using Type = std::decay_t<Func>;
+    return sizeof(Type) <= inlineSize && alignof(Type) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Type>;
+}
+}
+
+#endif // CS_TASK_HPP
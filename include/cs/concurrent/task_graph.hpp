@@ -0,0 +1,254 @@
+#ifndef CS_TASK_GRAPH_HPP
+#define CS_TASK_GRAPH_HPP
+
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <exception>
+#include <stdexcept>
+
+#include <cs/concurrent/task.hpp>
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace cs {
+// timings of one graph node
+struct NodeProfile {
+    std::string name;
+
+    // start offset from run start and duration of last run
+    std::chrono::nanoseconds start{0};
+    std::chrono::nanoseconds duration{0};
+
+    // sum of all runs durations
+    std::chrono::nanoseconds total{0};
+    uint64_t runs = 0;
+};
+
+// dependency graph of tasks, built once and executed many times at thread pool,
+// node starts when its last predecessor finishes, run does not allocate memory
+// warn: graph should not be changed or run concurrently while it is running
+class TaskGraph {
+public:
+    using NodeId = size_t;
+
+    explicit TaskGraph(ThreadPool& pool = ThreadPool::instance()):
+        pool_(pool) {}
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    // adds node, returns its id
+    template <typename Func>
+    NodeId add(Func&& func, std::string name = std::string{}) {
+        nodes_.emplace_back(Task(std::forward<Func>(func)), std::move(name));
+        prepared_ = false;
+
+        return nodes_.size() - 1;
+    }
+
+    // node 'to' starts after node 'from' is finished
+    void precede(NodeId from, NodeId to) {
+        if (from >= nodes_.size() || to >= nodes_.size() || from == to) {
+            throw std::out_of_range("TaskGraph has no such edge nodes");
+        }
+
+        nodes_[from].successors.push_back(to);
+        ++nodes_[to].predecessors;
+
+        prepared_ = false;
+    }
+
+    // runs all nodes and blocks until they are finished running queued pool tasks meanwhile,
+    // rethrows first node exception, nodes not started after exception are skipped
+    void run() {
+        if (nodes_.empty()) {
+            return;
+        }
+
+        if (!prepared_) {
+            prepare();
+        }
+
+        for (auto& node : nodes_) {
+            node.remaining.store(node.predecessors, std::memory_order_relaxed);
+        }
+
+        failed_.store(false, std::memory_order_relaxed);
+        exception_ = nullptr;
+        start_ = Clock::now();
+
+        pending_.store(nodes_.size(), std::memory_order_release);
+
+        for (auto root : roots_) {
+            pool_.enqueue([this, root] {
+                execute(root);
+            });
+        }
+
+        pool_.helpUntil([this] {
+            return pending_.load(std::memory_order_acquire) == 0;
+        });
+
+        if (exception_) {
+            std::rethrow_exception(std::exchange(exception_, nullptr));
+        }
+    }
+
+    // returns nodes count
+    size_t size() const noexcept {
+        return nodes_.size();
+    }
+
+    // returns timings of every node in node id order
+    std::vector<NodeProfile> profile() const {
+        std::vector<NodeProfile> result;
+        result.reserve(nodes_.size());
+
+        for (const auto& node : nodes_) {
+            result.push_back(node.profile);
+        }
+
+        return result;
+    }
+
+    // removes all nodes
+    void clear() {
+        nodes_.clear();
+        roots_.clear();
+        prepared_ = false;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Node {
+        Node(Task&& func, std::string&& name):
+            func(std::move(func)) {
+            profile.name = std::move(name);
+        }
+
+        Task func;
+        std::vector<NodeId> successors;
+        size_t predecessors = 0;
+
+        // predecessors left at current run
+        std::atomic<size_t> remaining = { 0 };
+
+        // written only by node executor
+        NodeProfile profile;
+    };
+
+    // finds roots and checks graph has no cycles
+    void prepare() {
+        std::vector<size_t> predecessors;
+        std::vector<NodeId> ready;
+
+        predecessors.reserve(nodes_.size());
+        roots_.clear();
+
+        for (NodeId i = 0; i < nodes_.size(); ++i) {
+            predecessors.push_back(nodes_[i].predecessors);
+
+            if (nodes_[i].predecessors == 0) {
+                roots_.push_back(i);
+            }
+        }
+
+        ready = roots_;
+        size_t visited = 0;
+
+        while (!ready.empty()) {
+            const auto id = ready.back();
+            ready.pop_back();
+            ++visited;
+
+            for (auto successor : nodes_[id].successors) {
+                if (--predecessors[successor] == 0) {
+                    ready.push_back(successor);
+                }
+            }
+        }
+
+        if (visited != nodes_.size()) {
+            throw std::logic_error("TaskGraph has cycle");
+        }
+
+        prepared_ = true;
+    }
+
+    // runs node and its successors, one ready successor continues at current thread
+    void execute(NodeId id) {
+        while (id != npos) {
+            auto& node = nodes_[id];
+
+            if (!failed_.load(std::memory_order_acquire)) {
+                const auto start = Clock::now();
+
+                try {
+                    node.func();
+                }
+                catch (...) {
+                    if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+                        exception_ = std::current_exception();
+                    }
+                }
+
+                const auto finish = Clock::now();
+
+                node.profile.start = std::chrono::duration_cast<std::chrono::nanoseconds>(start - start_);
+                node.profile.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start);
+                node.profile.total += node.profile.duration;
+                ++node.profile.runs;
+            }
+
+            NodeId next = npos;
+
+            for (auto successor : node.successors) {
+                if (nodes_[successor].remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                    continue;
+                }
+
+                if (next == npos) {
+                    next = successor;
+                }
+                else {
+                    pool_.enqueue([this, successor] {
+                        execute(successor);
+                    });
+                }
+            }
+
+            finish();
+            id = next;
+        }
+    }
+
+    void finish() {
+        // graph could be destroyed by run caller right after last decrement
+        auto& pool = pool_;
+
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            pool.notifyWaiters();
+        }
+    }
+
+    constexpr static NodeId npos = static_cast<NodeId>(-1);
+
+    ThreadPool& pool_;
+
+    std::deque<Node> nodes_;
+    std::vector<NodeId> roots_;
+    bool prepared_ = false;
+
+    std::atomic<size_t> pending_ = { 0 };
+    std::atomic<bool> failed_ = { false };
+    std::exception_ptr exception_;
+    Clock::time_point start_;
+};
+}
+
+#endif // CS_TASK_GRAPH_HPP
@@ -0,0 +1,125 @@
+#ifndef CS_TASK_GROUP_HPP
+#define CS_TASK_GROUP_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <exception>
+
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace cs {
+// structured fork join: children run at pool, wait runs queued pool tasks while children are not finished,
+// so nested groups do not block workers; first child exception cancels group and is rethrown by wait
+// warn: only one thread should wait for group at a time
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::instance()):
+        pool_(pool) {}
+
+    // waits for children, exception of not waited group is lost
+    ~TaskGroup() {
+        waitChildren();
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // runs func at pool as group child, child is skipped if group is cancelled before it starts
+    template <typename Func>
+    void run(Func&& func) {
+        state_.fetch_add(1, std::memory_order_relaxed);
+
+        try {
+            pool_.enqueue([this, func = std::forward<Func>(func)]() mutable {
+                if (!cancelled_.load(std::memory_order_acquire)) {
+                    try {
+                        func();
+                    }
+                    catch (...) {
+                        fail(std::current_exception());
+                    }
+                }
+
+                finish();
+            });
+        }
+        catch (...) {
+            finish();
+            throw;
+        }
+    }
+
+    // waits for all children running queued pool tasks meanwhile,
+    // rethrows first child exception
+    void wait() {
+        waitChildren();
+
+        if (failed_.load(std::memory_order_acquire)) {
+            auto exception = std::exchange(exception_, nullptr);
+            failed_.store(false, std::memory_order_relaxed);
+
+            std::rethrow_exception(exception);
+        }
+    }
+
+    // not started children are skipped, running children could check isCancelled
+    void cancel() noexcept {
+        cancelled_.store(true, std::memory_order_release);
+    }
+
+    bool isCancelled() const noexcept {
+        return cancelled_.load(std::memory_order_acquire);
+    }
+
+    // returns not finished children count
+    size_t size() const noexcept {
+        return static_cast<size_t>(state_.load(std::memory_order_acquire) & countMask);
+    }
+
+private:
+    // children count and waiter flag share one atomic,
+    // so last child knows if it should wake waiter without touching group after decrement
+    constexpr static uint64_t waiterFlag = uint64_t(1) << 63;
+    constexpr static uint64_t countMask = waiterFlag - 1;
+
+    void fail(std::exception_ptr exception) noexcept {
+        if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+            exception_ = std::move(exception);
+            cancelled_.store(true, std::memory_order_release);
+        }
+    }
+
+    void finish() {
+        // group could be destroyed by waiter right after decrement
+        auto& pool = pool_;
+
+        if (state_.fetch_sub(1, std::memory_order_acq_rel) == (waiterFlag | 1)) {
+            pool.notifyWaiters();
+        }
+    }
+
+    void waitChildren() {
+        if ((state_.load(std::memory_order_acquire) & countMask) == 0) {
+            return;
+        }
+
+        state_.fetch_or(waiterFlag, std::memory_order_acq_rel);
+
+        pool_.helpUntil([this] {
+            return (state_.load(std::memory_order_acquire) & countMask) == 0;
+        });
+
+        state_.fetch_and(countMask, std::memory_order_acq_rel);
+    }
+
+    ThreadPool& pool_;
+
+    std::atomic<uint64_t> state_ = { 0 };
+    std::atomic<bool> cancelled_ = { false };
+    std::atomic<bool> failed_ = { false };
+    std::exception_ptr exception_;
+};
+}
+
+#endif // CS_TASK_GROUP_HPP
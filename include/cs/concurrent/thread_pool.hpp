@@ -2,15 +2,34 @@
 #define CS_THREAD_POOL_HPP
 
 #include <vector>
+#include <deque>
 #include <queue>
 #include <future>
 #include <mutex>
-#include <functional>
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+
+#include <cs/utils/cache.hpp>
+#include <cs/utils/pause.hpp>
+#include <cs/utils/coroutine_support.hpp>
+#include <cs/containers/mpmc_queue.hpp>
+#include <cs/concurrent/task.hpp>
+#include <cs/concurrent/cancellation.hpp>
+#include <cs/concurrent/cpu_topology.hpp>
+#include <cs/concurrent/thread_pool_options.hpp>
+#include <cs/concurrent/thread_pool_stats.hpp>
 
 namespace cs {
+class BlockingRegion;
+
 class ThreadPool {
 public:
-   explicit ThreadPool(size_t threadsCount);
+    explicit ThreadPool(const ThreadPoolOptions& options);
+    explicit ThreadPool(size_t threadsCount, SchedulePolicy policy = SchedulePolicy::SharedQueue);
     ThreadPool();
     ~ThreadPool();
 
@@ -22,36 +41,372 @@ public:
     template<class F, class... Args>
     void enqueue(F&& f, Args&&... args);
 
+    // adds new task to queue if it has free slot, never blocks
+    // returns false if queue is full or pool is stopped
+    template<class F, class... Args>
+    bool tryEnqueue(F&& f, Args&&... args);
+
+    // adds task to priority lane, high and low lanes are shared by all workers at any schedule policy,
+    // normal priority is the same as enqueue without priority
+    template<class F, class... Args>
+    void enqueue(TaskPriority priority, F&& f, Args&&... args);
+
+    // adds urgent task, urgent tasks are taken earliest deadline first,
+    // high priority task is urgent task with deadline at its enqueue time,
+    // expired deadline only makes task more urgent, task is not dropped
+    template<class F, class... Args>
+    void enqueue(std::chrono::steady_clock::time_point deadline, F&& f, Args&&... args);
+
+    // adds task which is dropped without running if token is cancelled before task starts,
+    // running task could poll the same token
+    template<class F, class... Args>
+    void enqueue(CancellationToken token, F&& f, Args&&... args);
+
+    // adds range of functors to queue with one lock acquisition,
+    // wakes only as many parked workers as tasks were added
+    template<class Iterator>
+    void enqueueBulk(Iterator first, Iterator last);
+
+    // adds range of functors to queue and returns futures in the same order
+    template<class Iterator>
+    std::vector<std::future<std::invoke_result_t<typename std::iterator_traits<Iterator>::reference>>> enqueueBulkFuture(Iterator first, Iterator last);
+
+#ifdef CS_COROUTINES_SUPPORTED
+    // resumes awaiting coroutine at pool worker
+    class ScheduleAwaiter {
+    public:
+        explicit ScheduleAwaiter(ThreadPool& pool) noexcept:
+            pool_(pool) {}
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            pool_.enqueue([handle] {
+                handle.resume();
+            });
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        ThreadPool& pool_;
+    };
+
+    // co_await pool.schedule() continues coroutine at pool worker
+    ScheduleAwaiter schedule() noexcept {
+        return ScheduleAwaiter(*this);
+    }
+#endif
+
+    // runs one queued task at calling thread, returns false if there is no task,
+    // lets waiting code help pool instead of blocking worker
+    bool runPendingTask();
+
+    // runs queued tasks at calling thread until predicate is true and parks while queue is empty,
+    // code which makes predicate true should call notifyWaiters then
+    template<class Predicate>
+    void helpUntil(Predicate&& predicate);
+
+    // wakes threads parked at helpUntil
+    void notifyWaiters();
+
     // checks running state
     bool isRunning() const;
 
+    // returns running workers count
+    size_t size() const;
+
+    // returns maximal workers count
+    size_t capacity() const;
+
+    // returns current schedule policy
+    SchedulePolicy policy() const;
+
+    // returns pool creation options
+    const ThreadPoolOptions& options() const;
+
+    // returns pool gauges and worker metrics snapshot without locks,
+    // metrics are collected only if CS_THREAD_POOL_METRICS is defined
+    ThreadPoolStats stats() const;
+
     // get instace of thread pool
     // warn: be aware it creates static thread pool
     static ThreadPool& instance();
 
+    // returns pool of calling worker or nullptr at other threads
+    static ThreadPool* current() noexcept;
+
 private:
-    using Task = std::function<void()>;
+    // cs::Task or task with enqueue time if metrics are enabled
+    using Task = details::PoolTask;
+
+    // packs functor and arguments to one functor, arguments are stored by value as std::bind does
+    template<class F, class... Args>
+    static auto bind(F&& f, Args&&... args);
+
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    // task of high priority lane ordered by deadline, sequence keeps fifo order of equal deadlines
+    struct UrgentTask {
+        Deadline deadline;
+        uint64_t sequence;
+        Task task;
+
+        bool operator<(const UrgentTask& urgent) const noexcept {
+            return deadline != urgent.deadline ? deadline > urgent.deadline : sequence > urgent.sequence;
+        }
+    };
+
+    // worker own deque, owner pushes and pops at back, thieves steal from front
+    struct cacheline_aligned LocalQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // task which worker runs next, owner takes it at once, other worker stamps task it finds at slot
+    // by its look time and takes it if the same task is still there nextTaskAge later,
+    // so owner pays no clock read and task of blocked owner is not held forever,
+    // streak counts slot tasks taken in a row while queued tasks wait
+    struct cacheline_aligned NextTask {
+        std::atomic<bool> locked = { false };
+        std::atomic<bool> full = { false };
+        std::atomic<std::int64_t> seen = { 0 };
+        Task task;
+        size_t streak = 0;
+    };
+
+    constexpr static auto nextTaskAge = std::chrono::microseconds(100);
+
+    // preallocated worker place, elastic workers are started at inactive slots
+    struct WorkerSlot {
+        std::thread thread;
+        std::atomic<bool> active = { false };
+    };
 
     void enqueueImpl(Task&& task);
+    void enqueueBulkImpl(std::vector<Task>&& tasks);
+    bool tryEnqueueImpl(Task&& task);
+    void enqueuePrioritizedImpl(Task&& task, TaskPriority priority, Deadline deadline);
+
+    // pushes task to lock free ring resolving overflow by policy
+    void pushRing(Task&& task);
+
+    // tries to get task for worker by policy
+    bool pop(size_t index, Task& task);
+    bool popShared(Task& task);
+    bool popRing(Task& task);
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t index, Task& task);
+
+    // puts task of calling worker to its next task slot, returns task pushed out of slot
+    Task putNext(Task&& task);
+
+    // takes task of worker next task slot, slot yields to queued tasks after starvation limit unless forced
+    bool popNext(size_t index, Task& task, bool force);
+
+    // takes aged task of other worker next task slot and stamps fresh ones
+    bool stealNext(size_t index, Task& task);
+
+    // returns true if elastic pool would start worker for queued task, slot is skipped then
+    bool isGrowNeeded() const noexcept;
+
+    // locks slot spinning if wait is true, returns false if slot is locked by other thread otherwise
+    static bool lockNext(NextTask& next, bool wait) noexcept;
+    bool takeNext(NextTask& next, Task& task, bool wait);
+
+    // moves task of worker next task slot to queue, so other workers could take it at once
+    void flushNext();
+
+    // pushes task to queue by schedule policy
+    void pushQueue(Task&& task);
+
+    // takes urgent task or starved low task, returns false to let starved normal task go first
+    bool popPrioritized(Task& task);
+    bool popLow(Task& task);
+
+    // counts normal task taken while low tasks wait
+    void skipLow();
+
+    // wakes up to count parked workers
+    void wake(size_t count);
+
+    // parks worker until new tasks or stop, returns false if pool stopped or worker retired
+    bool park(size_t index);
+
+    // computes processors and domain of every worker slot by affinity policy
+    void place();
+
+    // starts worker thread at slot activated by caller
+    void start(size_t index);
+
+    // starts up to count elastic workers if tasks are queued and no worker is free
+    void grow(size_t count);
+
+    // deactivates elastic or compensation worker slot, returns false if worker should continue
+    // because tasks were added or worker was blocked again while it was retiring
+    bool retire(size_t index);
+
+    // compensation workers run at slots after capacity, slot is needed while enough workers are blocked
+    bool isCompensation(size_t index) const noexcept;
+    bool isCompensationNeeded(size_t index) const noexcept;
+
+    // counts calling worker as blocked and starts compensation worker if limit allows,
+    // returns false for non pool threads and nested regions
+    bool enterBlocking();
+    void leaveBlocking();
+
+    // spins and yields by options, returns true if tasks appeared or pool stopped
+    bool spin() const;
+
+    // reserves one of spinning workers places, spinning more workers than
+    // half of hardware threads only steals cpu from producers and busy workers
+    bool tryStartSpinning();
+
+    // waits for new tasks by idle policy, returns false if pool stopped
+    bool waitForTasks(size_t index);
+
+    // runs popped task and updates worker metrics
+    void run(size_t index, Task& task);
 
     // every thread loop
-    void routine();
+    void routine(size_t index);
 
+    const ThreadPoolOptions options_;
+
+    // shared queue or injection queue at work stealing policy
     std::queue<Task> tasks_;
-    std::vector<std::thread> workers_;
+    std::unique_ptr<WorkerSlot[]> workers_;
+    std::unique_ptr<LocalQueue[]> queues_;
+    std::unique_ptr<NextTask[]> next_;
+    std::atomic<size_t> nextCount_ = { 0 };
+
+    // parked workers which look at next slots every nextTaskAge
+    std::atomic<size_t> watching_ = { 0 };
+    std::unique_ptr<MpmcQueue<Task>> ring_;
+
+    // priority lanes guarded by mutex_, urgent tasks are binary heap by deadline
+    std::vector<UrgentTask> urgentTasks_;
+    std::queue<Task> lowTasks_;
+    uint64_t urgentSequence_ = 0;
+    size_t urgentStreak_ = 0;
 
     mutable std::mutex mutex_;
     std::condition_variable notifier_;
+    std::condition_variable spaceNotifier_;
+
+    // approximate count of queued tasks, parked workers and producers blocked on full ring
+    cacheline_aligned std::atomic<std::int64_t> pending_ = { 0 };
+    cacheline_aligned std::atomic<size_t> idle_ = { 0 };
+    std::atomic<size_t> blockedProducers_ = { 0 };
+
+    // priority lanes sizes, workers touch lanes only if they are not empty
+    std::atomic<size_t> urgentCount_ = { 0 };
+    std::atomic<size_t> lowCount_ = { 0 };
+
+    // normal and urgent tasks taken while low tasks wait
+    std::atomic<size_t> lowSkips_ = { 0 };
+
+    // count of workers spinning by SpinThenPark policy
+    std::atomic<size_t> spinning_ = { 0 };
+
+    // worker slots count and running workers count, they differ only at elastic pool
+    const size_t capacity_;
+    std::atomic<size_t> size_ = { 0 };
+    std::mutex growMutex_;
+
+    // slots of permanent, elastic and compensation workers, blocked workers count
+    const size_t slotsCount_;
+    std::atomic<size_t> blocked_ = { 0 };
+
+    // processors and domain of every worker slot, empty processors list means unpinned worker,
+    // thieves try own domain first only if workers are spread over several domains
+    std::vector<std::vector<unsigned>> placements_;
+    std::vector<size_t> domains_;
+    bool localSteal_ = false;
+
+#ifdef CS_THREAD_POOL_METRICS
+    std::unique_ptr<details::WorkerMetrics[]> metrics_;
+#endif
+
+    std::atomic<bool> stop_ = { false };
+
+    // worker thread identity
+    inline static thread_local ThreadPool* current_ = nullptr;
+    inline static thread_local size_t currentIndex_ = 0;
+    inline static thread_local bool blocking_ = false;
+
+    friend class BlockingRegion;
+};
+
+// marks calling worker as blocked by io or other waiting, its pool starts compensation worker
+// if compensationLimit allows, so cpu tasks keep full parallelism while region is alive,
+// region at non pool thread or inside other region does nothing
+class BlockingRegion {
+public:
+    BlockingRegion():
+        pool_(ThreadPool::current_),
+        entered_(pool_ != nullptr && pool_->enterBlocking()) {}
+
+    ~BlockingRegion() {
+        if (entered_) {
+            pool_->leaveBlocking();
+        }
+    }
 
-    bool stop_ = false;
+    BlockingRegion(const BlockingRegion&) = delete;
+    BlockingRegion& operator=(const BlockingRegion&) = delete;
+
+private:
+    ThreadPool* pool_;
+    bool entered_;
 };
- 
-inline ThreadPool::ThreadPool(size_t threads) {
-    for (size_t i = 0; i < threads; ++i) {
-        workers_.emplace_back(&ThreadPool::routine, this);
+
+// calls func inside blocking region and returns its result
+template <typename Func>
+decltype(auto) blocking(Func&& func) {
+    BlockingRegion region;
+    return std::forward<Func>(func)();
+}
+
+inline ThreadPool::ThreadPool(const ThreadPoolOptions& options):
+    options_(options),
+    capacity_(std::max(options.threadsCount, options.maxThreadsCount)),
+    slotsCount_(capacity_ + options.compensationLimit) {
+    workers_ = std::make_unique<WorkerSlot[]>(slotsCount_);
+    place();
+
+    if (options_.nextTaskSlot) {
+        next_ = std::make_unique<NextTask[]>(slotsCount_);
+    }
+
+#ifdef CS_THREAD_POOL_METRICS
+    metrics_ = std::make_unique<details::WorkerMetrics[]>(slotsCount_);
+#endif
+
+    if (options_.schedule == SchedulePolicy::WorkStealing) {
+        queues_ = std::make_unique<LocalQueue[]>(slotsCount_);
+    }
+    else if (options_.schedule == SchedulePolicy::LockFree) {
+        ring_ = std::make_unique<MpmcQueue<Task>>(options_.capacity);
+    }
+
+    for (size_t i = 0; i < options_.threadsCount; ++i) {
+        workers_[i].active.store(true, std::memory_order_relaxed);
+        start(i);
     }
 }
 
+inline ThreadPool::ThreadPool(size_t threads, SchedulePolicy policy):
+    ThreadPool([threads, policy] {
+        ThreadPoolOptions options;
+        options.threadsCount = threads;
+        options.schedule = policy;
+
+        return options;
+    }()) {}
+
 inline ThreadPool::ThreadPool():ThreadPool(std::thread::hardware_concurrency()) {}
 
 inline ThreadPool::~ThreadPool() {
@@ -61,9 +416,14 @@ inline ThreadPool::~ThreadPool() {
     }
 
     notifier_.notify_all();
+    spaceNotifier_.notify_all();
 
-    for (auto& worker : workers_) {
-        worker.join();
+    std::lock_guard lock(growMutex_);
+
+    for (size_t i = 0; i < slotsCount_; ++i) {
+        if (workers_[i].thread.joinable()) {
+            workers_[i].thread.join();
+        }
     }
 }
 
@@ -71,19 +431,106 @@ template<class F, class... Args>
 inline std::future<std::invoke_result_t<F, Args...>> ThreadPool::enqueueFuture(F&& f, Args&&... args) {
     using ResultType = std::invoke_result_t<F, Args...>;
 
-    const auto task = std::make_shared<std::packaged_task<ResultType()>>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-    auto res = task->get_future();
+    std::packaged_task<ResultType()> task(ThreadPool::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    auto res = task.get_future();
 
-    enqueueImpl([task] {
-        (*task)();
-    });
+    enqueueImpl(Task(std::move(task)));
 
     return res;
 }
 
 template<class F, class... Args>
 inline void ThreadPool::enqueue(F&& f, Args&&... args) {
-    enqueueImpl(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    enqueueImpl(Task(ThreadPool::bind(std::forward<F>(f), std::forward<Args>(args)...)));
+}
+
+template<class F, class... Args>
+inline bool ThreadPool::tryEnqueue(F&& f, Args&&... args) {
+    return tryEnqueueImpl(Task(ThreadPool::bind(std::forward<F>(f), std::forward<Args>(args)...)));
+}
+
+template<class F, class... Args>
+inline void ThreadPool::enqueue(TaskPriority priority, F&& f, Args&&... args) {
+    enqueuePrioritizedImpl(Task(ThreadPool::bind(std::forward<F>(f), std::forward<Args>(args)...)), priority, Deadline::clock::now());
+}
+
+template<class F, class... Args>
+inline void ThreadPool::enqueue(std::chrono::steady_clock::time_point deadline, F&& f, Args&&... args) {
+    enqueuePrioritizedImpl(Task(ThreadPool::bind(std::forward<F>(f), std::forward<Args>(args)...)), TaskPriority::High, deadline);
+}
+
+template<class F, class... Args>
+inline void ThreadPool::enqueue(CancellationToken token, F&& f, Args&&... args) {
+    enqueueImpl(Task([token = std::move(token), func = ThreadPool::bind(std::forward<F>(f), std::forward<Args>(args)...)]() mutable {
+        if (!token.isCancelled()) {
+            func();
+        }
+    }));
+}
+
+template<class Iterator>
+inline void ThreadPool::enqueueBulk(Iterator first, Iterator last) {
+    std::vector<Task> tasks;
+    tasks.reserve(static_cast<size_t>(std::distance(first, last)));
+
+    for (; first != last; ++first) {
+        tasks.emplace_back(*first);
+    }
+
+    enqueueBulkImpl(std::move(tasks));
+}
+
+template<class Iterator>
+inline std::vector<std::future<std::invoke_result_t<typename std::iterator_traits<Iterator>::reference>>> ThreadPool::enqueueBulkFuture(Iterator first, Iterator last) {
+    using ResultType = std::invoke_result_t<typename std::iterator_traits<Iterator>::reference>;
+    using FunctorType = std::decay_t<typename std::iterator_traits<Iterator>::reference>;
+
+    const auto size = static_cast<size_t>(std::distance(first, last));
+
+    std::vector<std::future<ResultType>> futures;
+    std::vector<Task> tasks;
+
+    futures.reserve(size);
+    tasks.reserve(size);
+
+    for (; first != last; ++first) {
+        std::packaged_task<ResultType()> task{FunctorType(*first)};
+
+        futures.push_back(task.get_future());
+        tasks.emplace_back(std::move(task));
+    }
+
+    enqueueBulkImpl(std::move(tasks));
+
+    return futures;
+}
+
+template<class Predicate>
+inline void ThreadPool::helpUntil(Predicate&& predicate) {
+    for (;;) {
+        if (predicate()) {
+            return;
+        }
+
+        if (runPendingTask()) {
+            continue;
+        }
+
+        // waiter is counted as idle worker, so producers wake it for new tasks
+        std::unique_lock lock(mutex_);
+        idle_.fetch_add(1, std::memory_order_seq_cst);
+
+        notifier_.wait(lock, [&] {
+            return stop_ || pending_.load(std::memory_order_seq_cst) > 0 || predicate();
+        });
+
+        idle_.fetch_sub(1, std::memory_order_relaxed);
+
+        // nobody would run queued tasks of stopped pool
+        if (stop_ && pending_.load(std::memory_order_seq_cst) <= 0) {
+            return;
+        }
+    }
 }
 
 inline bool ThreadPool::isRunning() const {
@@ -91,47 +538,1073 @@ inline bool ThreadPool::isRunning() const {
     return stop_;
 }
 
+inline size_t ThreadPool::size() const {
+    return size_.load(std::memory_order_acquire);
+}
+
+inline size_t ThreadPool::capacity() const {
+    return capacity_;
+}
+
+inline SchedulePolicy ThreadPool::policy() const {
+    return options_.schedule;
+}
+
+inline const ThreadPoolOptions& ThreadPool::options() const {
+    return options_;
+}
+
+inline bool ThreadPool::runPendingTask() {
+    Task task;
+
+    if (current_ == this) {
+        if (!pop(currentIndex_, task)) {
+            return false;
+        }
+
+        run(currentIndex_, task);
+        return true;
+    }
+
+    // aged slot task could be waited by its blocked owner, so it goes before queued tasks
+    bool popped = popPrioritized(task) || stealNext(0, task);
+
+    if (!popped) {
+        switch (options_.schedule) {
+        case SchedulePolicy::SharedQueue:
+            popped = popShared(task);
+            break;
+
+        case SchedulePolicy::WorkStealing:
+            popped = popShared(task) || steal(0, task);
+            break;
+
+        case SchedulePolicy::LockFree:
+            popped = popRing(task);
+            break;
+        }
+
+        if (popped) {
+            skipLow();
+        }
+        else {
+            popped = popLow(task);
+        }
+    }
+
+    if (popped) {
+        task();
+    }
+
+    return popped;
+}
+
+inline void ThreadPool::notifyWaiters() {
+    {
+        std::lock_guard lock(mutex_);
+    }
+
+    notifier_.notify_all();
+}
+
+inline ThreadPoolStats ThreadPool::stats() const {
+    ThreadPoolStats stats;
+
+    stats.queueDepth = static_cast<size_t>(std::max<std::int64_t>(pending_.load(std::memory_order_relaxed), 0));
+    stats.workersCount = size();
+    stats.idleWorkers = idle_.load(std::memory_order_relaxed);
+
+#ifdef CS_THREAD_POOL_METRICS
+    stats.enabled = true;
+    stats.workers.resize(slotsCount_);
+
+    for (size_t i = 0; i < slotsCount_; ++i) {
+        const auto& metrics = metrics_[i];
+        auto& worker = stats.workers[i];
+
+        worker.active = workers_[i].active.load(std::memory_order_relaxed);
+        worker.tasks = metrics.tasks.load();
+        worker.steals = metrics.steals.load();
+        worker.busyTime = std::chrono::nanoseconds(metrics.busyTime.load());
+        worker.idleTime = std::chrono::nanoseconds(metrics.idleTime.load());
+        worker.waitTime = metrics.waitTime.load();
+        worker.executionTime = metrics.executionTime.load();
+
+        stats.waitTime.merge(worker.waitTime);
+        stats.executionTime.merge(worker.executionTime);
+    }
+#endif
+
+    return stats;
+}
+
 inline ThreadPool& ThreadPool::instance() {
-    static ThreadPool pool;
+    // global pool runs cpu tasks, so every blocked worker is compensated
+    static ThreadPool pool([] {
+        ThreadPoolOptions options;
+        options.compensationLimit = options.threadsCount;
+
+        return options;
+    }());
+
     return pool;
 }
 
+inline ThreadPool* ThreadPool::current() noexcept {
+    return current_;
+}
+
+template<class F, class... Args>
+inline auto ThreadPool::bind(F&& f, Args&&... args) {
+    if constexpr (sizeof...(Args) == 0) {
+        return std::decay_t<F>(std::forward<F>(f));
+    }
+    else {
+        return [func = std::forward<F>(f), arguments = std::make_tuple(std::forward<Args>(args)...)]() mutable -> decltype(auto) {
+            return std::apply(func, arguments);
+        };
+    }
+}
+
 inline void ThreadPool::enqueueImpl(ThreadPool::Task&& task) {
-    {
-        if (stop_) {
-            throw std::runtime_error("enqueue on stopped ThreadPool");
+    if (stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("enqueue on stopped ThreadPool");
+    }
+
+    // follow up task of worker runs next at the same worker without touching queue locks,
+    // previous slot task goes to queue instead, so nested submissions keep lifo order,
+    // task which needs new worker of elastic pool goes to queue, as owner could wait for it
+    if (next_ && current_ == this && !isGrowNeeded()) {
+        task = putNext(std::move(task));
+
+        if (!task) {
+            return;
+        }
+    }
+
+    pushQueue(std::move(task));
+}
+
+inline void ThreadPool::pushQueue(ThreadPool::Task&& task) {
+    if (options_.schedule == SchedulePolicy::LockFree) {
+        pushRing(std::move(task));
+        return;
+    }
+
+    // worker of this pool pushes to own deque without touching shared lock
+    if (options_.schedule == SchedulePolicy::WorkStealing && current_ == this) {
+        auto& queue = queues_[currentIndex_];
+
+        {
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
         }
 
+        pending_.fetch_add(1, std::memory_order_seq_cst);
+        wake(1);
+
+        return;
+    }
+
+    {
         std::lock_guard lock(mutex_);
 
         tasks_.emplace(std::move(task));
+        pending_.fetch_add(1, std::memory_order_seq_cst);
     }
 
-    notifier_.notify_one();
+    if (idle_.load(std::memory_order_seq_cst) != 0) {
+        notifier_.notify_one();
+    }
+    else {
+        grow(1);
+    }
 }
 
-inline void ThreadPool::routine() {
-    for (;;) {
-        Task task;
+inline void ThreadPool::enqueueBulkImpl(std::vector<Task>&& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
 
-        {
-            std::unique_lock lock(mutex_);
+    if (stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("enqueue on stopped ThreadPool");
+    }
 
-            notifier_.wait(lock, [pool = this] {
-                return pool->stop_ || !pool->tasks_.empty();
-            });
+    const auto count = tasks.size();
 
-            if (stop_) {
-                break;
-            }
+    if (options_.schedule == SchedulePolicy::LockFree) {
+        size_t pushed = 0;
 
-            if (!tasks_.empty()) {
-                task = std::move(tasks_.front());
-                tasks_.pop();
+        for (auto& task : tasks) {
+            if (ring_->tryPush(std::move(task))) {
+                ++pushed;
+                continue;
             }
+
+            // let workers drain ring before waiting for free slot
+            pending_.fetch_add(static_cast<std::int64_t>(pushed), std::memory_order_seq_cst);
+            wake(pushed);
+            pushed = 0;
+
+            pushRing(std::move(task));
         }
 
-        task();
+        pending_.fetch_add(static_cast<std::int64_t>(pushed), std::memory_order_seq_cst);
+        wake(pushed);
+
+        return;
+    }
+
+    if (options_.schedule == SchedulePolicy::WorkStealing && current_ == this) {
+        auto& queue = queues_[currentIndex_];
+
+        {
+            std::lock_guard lock(queue.mutex);
+            std::move(tasks.begin(), tasks.end(), std::back_inserter(queue.tasks));
+        }
+
+        pending_.fetch_add(static_cast<std::int64_t>(count), std::memory_order_seq_cst);
+        wake(count);
+
+        return;
+    }
+
+    size_t idle = 0;
+
+    {
+        std::lock_guard lock(mutex_);
+
+        for (auto& task : tasks) {
+            tasks_.push(std::move(task));
+        }
+
+        pending_.fetch_add(static_cast<std::int64_t>(count), std::memory_order_seq_cst);
+        idle = idle_.load(std::memory_order_seq_cst);
+    }
+
+    if (idle == 0) {
+        grow(count);
+        return;
+    }
+
+    if (count >= idle) {
+        notifier_.notify_all();
+    }
+    else {
+        for (size_t i = 0; i < count; ++i) {
+            notifier_.notify_one();
+        }
+    }
+}
+
+inline bool ThreadPool::tryEnqueueImpl(Task&& task) {
+    if (stop_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    if (options_.schedule != SchedulePolicy::LockFree) {
+        enqueueImpl(std::move(task));
+        return true;
+    }
+
+    if (!ring_->tryPush(std::move(task))) {
+        return false;
+    }
+
+    pending_.fetch_add(1, std::memory_order_seq_cst);
+    wake(1);
+
+    return true;
+}
+
+inline void ThreadPool::enqueuePrioritizedImpl(Task&& task, TaskPriority priority, Deadline deadline) {
+    if (priority == TaskPriority::Normal) {
+        enqueueImpl(std::move(task));
+        return;
+    }
+
+    if (stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("enqueue on stopped ThreadPool");
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+
+        if (priority == TaskPriority::Low) {
+            lowTasks_.push(std::move(task));
+            lowCount_.fetch_add(1, std::memory_order_release);
+        }
+        else {
+            urgentTasks_.push_back(UrgentTask{deadline, urgentSequence_++, std::move(task)});
+            std::push_heap(urgentTasks_.begin(), urgentTasks_.end());
+            urgentCount_.fetch_add(1, std::memory_order_release);
+        }
+
+        pending_.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    if (idle_.load(std::memory_order_seq_cst) != 0) {
+        notifier_.notify_one();
+    }
+    else {
+        grow(1);
+    }
+}
+
+inline void ThreadPool::pushRing(Task&& task) {
+    for (size_t spins = 0; !ring_->tryPush(std::move(task)); ++spins) {
+        if (stop_.load(std::memory_order_acquire)) {
+            throw std::runtime_error("enqueue on stopped ThreadPool");
+        }
+
+        if (options_.overflow == OverflowPolicy::Fail) {
+            throw std::runtime_error("enqueue on full ThreadPool queue");
+        }
+
+        // worker waiting for space at own full ring could never be released, so it runs task itself
+        if (current_ == this) {
+            task();
+            return;
+        }
+
+        if (options_.overflow == OverflowPolicy::Spin) {
+            constexpr size_t pauseSpins = 64;
+
+            if (spins < pauseSpins) {
+                details::cpuPause();
+            }
+            else {
+                std::this_thread::yield();
+            }
+
+            continue;
+        }
+
+        // elastic pool adds workers before producer blocks
+        grow(1);
+
+        std::unique_lock lock(mutex_);
+        blockedProducers_.fetch_add(1, std::memory_order_seq_cst);
+
+        spaceNotifier_.wait(lock, [pool = this] {
+            return pool->stop_ || !pool->ring_->isFull();
+        });
+
+        blockedProducers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    pending_.fetch_add(1, std::memory_order_seq_cst);
+    wake(1);
+}
+
+inline bool ThreadPool::pop(size_t index, Task& task) {
+    // aged slot task could be waited by its blocked owner, so it goes before queued tasks
+    if (popPrioritized(task) || popNext(index, task, false) || stealNext(index, task)) {
+        return true;
+    }
+
+    bool popped = false;
+
+    switch (options_.schedule) {
+    case SchedulePolicy::SharedQueue:
+        popped = popShared(task);
+        break;
+
+    case SchedulePolicy::WorkStealing:
+        popped = popLocal(index, task) || popShared(task) || steal(index, task);
+        break;
+
+    case SchedulePolicy::LockFree:
+        popped = popRing(task);
+        break;
+    }
+
+    if (popped) {
+        skipLow();
+        return true;
+    }
+
+    // slot task yielded to empty queues
+    return popLow(task) || popNext(index, task, true);
+}
+
+inline bool ThreadPool::popShared(Task& task) {
+    std::lock_guard lock(mutex_);
+
+    if (tasks_.empty()) {
+        return false;
+    }
+
+    task = std::move(tasks_.front());
+    tasks_.pop();
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+
+    return true;
+}
+
+inline bool ThreadPool::popRing(Task& task) {
+    if (!ring_->tryPop(task)) {
+        return false;
+    }
+
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+
+    // blocked producer checks ring under mutex, see wake
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (blockedProducers_.load(std::memory_order_relaxed) != 0) {
+        {
+            std::lock_guard lock(mutex_);
+        }
+
+        spaceNotifier_.notify_one();
+    }
+
+    return true;
+}
+
+inline bool ThreadPool::popLocal(size_t index, Task& task) {
+    auto& queue = queues_[index];
+    std::lock_guard lock(queue.mutex);
+
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+
+    return true;
+}
+
+inline bool ThreadPool::steal(size_t index, Task& task) {
+    const size_t count = slotsCount_;
+    const size_t domain = index < count ? domains_[index] : 0;
+
+    // own domain is scanned at first pass, its tasks data is likely at shared cache,
+    // own queue is checked last, worker checked it already, external helper passes any index
+    const size_t passes = localSteal_ ? 2 : 1;
+
+    for (size_t step = 0; step < passes * count; ++step) {
+        const size_t victim = (index + step % count + 1) % count;
+        const bool firstPass = step < count;
+
+        if (localSteal_ && (domains_[victim] == domain) != firstPass) {
+            continue;
+        }
+
+        auto& queue = queues_[victim];
+        std::unique_lock lock(queue.mutex, std::try_to_lock);
+
+        if (!lock.owns_lock() || queue.tasks.empty()) {
+            continue;
+        }
+
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+
+#ifdef CS_THREAD_POOL_METRICS
+        if (current_ == this) {
+            metrics_[index].steals.add(1);
+        }
+#endif
+
+        return true;
+    }
+
+    return false;
+}
+
+inline ThreadPool::Task ThreadPool::putNext(Task&& task) {
+    auto& next = next_[currentIndex_];
+    lockNext(next, true);
+
+    Task previous = std::exchange(next.task, std::move(task));
+    next.full.store(true, std::memory_order_relaxed);
+    next.seen.store(0, std::memory_order_relaxed);
+    next.locked.store(false, std::memory_order_release);
+
+    if (previous) {
+        return previous;
+    }
+
+    // first slot task wakes parked worker if none looks at slots already, so slots are checked after their age
+    if (nextCount_.fetch_add(1, std::memory_order_seq_cst) == 0 && watching_.load(std::memory_order_seq_cst) == 0 &&
+        idle_.load(std::memory_order_seq_cst) != 0) {
+        {
+            std::lock_guard lock(mutex_);
+        }
+
+        notifier_.notify_one();
+    }
+
+    return previous;
+}
+
+inline bool ThreadPool::popNext(size_t index, Task& task, bool force) {
+    if (!next_ || current_ != this) {
+        return false;
+    }
+
+    auto& next = next_[index];
+
+    // only owner fills slot, so its view of slot is exact
+    if (!next.full.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    if (force) {
+        next.streak = 0;
+    }
+    else if (++next.streak > options_.starvationLimit) {
+        next.streak = 0;
+        return false;
+    }
+
+    if (!takeNext(next, task, true)) {
+        return false;
+    }
+
+    if (!force) {
+        skipLow();
+    }
+
+    return true;
+}
+
+inline bool ThreadPool::stealNext(size_t index, Task& task) {
+    if (!next_ || nextCount_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    const auto age = std::chrono::duration_cast<std::chrono::steady_clock::duration>(nextTaskAge).count();
+    std::int64_t now = 0;
+
+    for (size_t i = 1; i <= slotsCount_; ++i) {
+        auto& next = next_[(index + i) % slotsCount_];
+
+        if (!next.full.load(std::memory_order_relaxed)) {
+            continue;
+        }
+
+        // clock is read once per scan and only if some slot is full
+        if (now == 0) {
+            now = std::chrono::steady_clock::now().time_since_epoch().count();
+        }
+
+        std::int64_t seen = next.seen.load(std::memory_order_relaxed);
+
+        // fresh task is only stamped, idle worker looks again after parking for nextTaskAge
+        if (seen == 0) {
+            next.seen.compare_exchange_strong(seen, now, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (now - seen < age || !takeNext(next, task, false)) {
+            continue;
+        }
+
+#ifdef CS_THREAD_POOL_METRICS
+        if (current_ == this) {
+            metrics_[index].steals.add(1);
+        }
+#endif
+
+        return true;
+    }
+
+    return false;
+}
+
+inline bool ThreadPool::isGrowNeeded() const noexcept {
+    return capacity_ != options_.threadsCount && idle_.load(std::memory_order_seq_cst) == 0 &&
+           spinning_.load(std::memory_order_seq_cst) == 0 && size_.load(std::memory_order_acquire) < capacity_;
+}
+
+inline bool ThreadPool::lockNext(NextTask& next, bool wait) noexcept {
+    while (next.locked.exchange(true, std::memory_order_acquire)) {
+        if (!wait) {
+            return false;
+        }
+
+        details::cpuPause();
+    }
+
+    return true;
+}
+
+inline bool ThreadPool::takeNext(NextTask& next, Task& task, bool wait) {
+    if (!lockNext(next, wait)) {
+        return false;
+    }
+
+    const bool taken = static_cast<bool>(next.task);
+
+    if (taken) {
+        task = std::move(next.task);
+        next.full.store(false, std::memory_order_relaxed);
+        nextCount_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    next.locked.store(false, std::memory_order_release);
+    return taken;
+}
+
+inline void ThreadPool::flushNext() {
+    if (!next_ || current_ != this) {
+        return;
+    }
+
+    Task task;
+
+    if (takeNext(next_[currentIndex_], task, true)) {
+        pushQueue(std::move(task));
+    }
+}
+
+inline bool ThreadPool::popPrioritized(Task& task) {
+    if (urgentCount_.load(std::memory_order_acquire) == 0 && lowSkips_.load(std::memory_order_relaxed) < options_.starvationLimit) {
+        return false;
+    }
+
+    std::lock_guard lock(mutex_);
+
+    // skipped counter could be left by last low task taken concurrently
+    if (lowTasks_.empty()) {
+        lowSkips_.store(0, std::memory_order_relaxed);
+    }
+    else if (lowSkips_.load(std::memory_order_relaxed) >= options_.starvationLimit) {
+        // low task waited for starvation limit tasks of other lanes
+        task = std::move(lowTasks_.front());
+        lowTasks_.pop();
+
+        lowCount_.fetch_sub(1, std::memory_order_relaxed);
+        lowSkips_.store(0, std::memory_order_relaxed);
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    if (urgentTasks_.empty()) {
+        return false;
+    }
+
+    // queued tasks except lanes are normal ones
+    const auto prioritized = static_cast<std::int64_t>(urgentTasks_.size() + lowTasks_.size());
+    const bool normalWaits = pending_.load(std::memory_order_relaxed) > prioritized;
+
+    if (normalWaits && urgentStreak_ >= options_.starvationLimit) {
+        urgentStreak_ = 0;
+        return false;
+    }
+
+    std::pop_heap(urgentTasks_.begin(), urgentTasks_.end());
+    task = std::move(urgentTasks_.back().task);
+    urgentTasks_.pop_back();
+
+    urgentStreak_ = normalWaits ? urgentStreak_ + 1 : 0;
+
+    urgentCount_.fetch_sub(1, std::memory_order_relaxed);
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+
+    if (!lowTasks_.empty()) {
+        lowSkips_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return true;
+}
+
+inline bool ThreadPool::popLow(Task& task) {
+    if (lowCount_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    std::lock_guard lock(mutex_);
+
+    if (lowTasks_.empty()) {
+        return false;
+    }
+
+    task = std::move(lowTasks_.front());
+    lowTasks_.pop();
+
+    lowCount_.fetch_sub(1, std::memory_order_relaxed);
+    lowSkips_.store(0, std::memory_order_relaxed);
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+
+    return true;
+}
+
+inline void ThreadPool::skipLow() {
+    if (lowCount_.load(std::memory_order_relaxed) != 0) {
+        lowSkips_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline void ThreadPool::wake(size_t count) {
+    const size_t idle = idle_.load(std::memory_order_seq_cst);
+
+    if (count == 0) {
+        return;
+    }
+
+    if (idle == 0) {
+        grow(count);
+        return;
+    }
+
+    // parked worker checks pending count under mutex, so taking it here
+    // guarantees worker is either waiting already or would see new task
+    {
+        std::lock_guard lock(mutex_);
+    }
+
+    if (count >= idle) {
+        notifier_.notify_all();
+    }
+    else {
+        for (size_t i = 0; i < count; ++i) {
+            notifier_.notify_one();
+        }
+    }
+}
+
+inline bool ThreadPool::park(size_t index) {
+    std::unique_lock lock(mutex_);
+    idle_.fetch_add(1, std::memory_order_seq_cst);
+
+    auto ready = [pool = this] {
+        return pool->stop_ || pool->pending_.load(std::memory_order_seq_cst) > 0;
+    };
+
+    // next slot tasks are not counted as pending and could be taken only after their age,
+    // so worker is woken by first slot task and looks at slots again after their age
+    auto wakeable = [&] {
+        return ready() || nextCount_.load(std::memory_order_seq_cst) != 0;
+    };
+
+    if (nextCount_.load(std::memory_order_seq_cst) != 0) {
+        watching_.fetch_add(1, std::memory_order_seq_cst);
+        notifier_.wait_for(lock, nextTaskAge, ready);
+        watching_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+    else if (index < options_.threadsCount) {
+        notifier_.wait(lock, wakeable);
+    }
+    else if (isCompensation(index)) {
+        // routine retires unneeded worker after wake up
+        notifier_.wait(lock, [&] {
+            return wakeable() || !isCompensationNeeded(index);
+        });
+    }
+    else if (!notifier_.wait_for(lock, options_.idleTimeout, wakeable)) {
+        idle_.fetch_sub(1, std::memory_order_seq_cst);
+        lock.unlock();
+
+        return !retire(index);
+    }
+
+    idle_.fetch_sub(1, std::memory_order_relaxed);
+    return !stop_;
+}
+
+inline void ThreadPool::place() {
+    placements_.resize(slotsCount_);
+    domains_.assign(slotsCount_, 0);
+
+    if (options_.affinity == AffinityPolicy::None || slotsCount_ == 0) {
+        return;
+    }
+
+    const auto& topology = CpuTopology::instance();
+
+    if (options_.affinity == AffinityPolicy::Explicit) {
+        if (options_.cpuSets.empty()) {
+            return;
+        }
+
+        for (size_t i = 0; i < slotsCount_; ++i) {
+            placements_[i] = options_.cpuSets[i % options_.cpuSets.size()];
+            domains_[i] = placements_[i].empty() ? 0 : topology.domainOf(placements_[i].front());
+        }
+    }
+    else {
+        const auto cpus = topology.spread();
+
+        for (size_t i = 0; i < slotsCount_; ++i) {
+            const auto cpu = cpus[i % cpus.size()];
+
+            placements_[i] = { cpu };
+            domains_[i] = topology.domainOf(cpu);
+        }
+    }
+
+    localSteal_ = std::any_of(domains_.begin(), domains_.end(), [this](size_t domain) {
+        return domain != domains_.front();
+    });
+}
+
+inline void ThreadPool::start(size_t index) {
+    auto& slot = workers_[index];
+
+    // previous worker of slot is retired already and exits
+    if (slot.thread.joinable()) {
+        slot.thread.join();
+    }
+
+    try {
+        slot.thread = std::thread(&ThreadPool::routine, this, index);
+    }
+    catch (...) {
+        slot.active.store(false, std::memory_order_seq_cst);
+        throw;
+    }
+
+    size_.fetch_add(1, std::memory_order_release);
+}
+
+inline void ThreadPool::grow(size_t count) {
+    if (capacity_ == options_.threadsCount || count == 0) {
+        return;
+    }
+
+    auto backlog = [this] {
+        return idle_.load(std::memory_order_seq_cst) == 0 && spinning_.load(std::memory_order_seq_cst) == 0 &&
+               pending_.load(std::memory_order_seq_cst) > 0 && size_.load(std::memory_order_acquire) < capacity_;
+    };
+
+    if (!backlog()) {
+        return;
+    }
+
+    std::lock_guard lock(growMutex_);
+
+    for (size_t i = options_.threadsCount; i < capacity_ && count != 0 && backlog(); ++i) {
+        if (stop_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        bool expected = false;
+
+        if (!workers_[i].active.compare_exchange_strong(expected, true, std::memory_order_seq_cst)) {
+            continue;
+        }
+
+        try {
+            start(i);
+            --count;
+        }
+        catch (...) {
+            // queued task waits for running or next started worker
+            return;
+        }
+    }
+}
+
+inline bool ThreadPool::retire(size_t index) {
+    auto& slot = workers_[index];
+
+    size_.fetch_sub(1, std::memory_order_release);
+    slot.active.store(false, std::memory_order_seq_cst);
+
+    // producer could count this worker as idle and notify nobody, so task added meanwhile
+    // is taken by this worker again unless slot is already used by new worker,
+    // compensation slot is taken again by the same way if worker was blocked meanwhile
+    const bool needed = isCompensation(index) ? isCompensationNeeded(index) : pending_.load(std::memory_order_seq_cst) > 0;
+
+    if (stop_.load(std::memory_order_acquire) || !needed) {
+        return true;
+    }
+
+    bool expected = false;
+
+    if (!slot.active.compare_exchange_strong(expected, true, std::memory_order_seq_cst)) {
+        return true;
+    }
+
+    size_.fetch_add(1, std::memory_order_release);
+    return false;
+}
+
+inline bool ThreadPool::isCompensation(size_t index) const noexcept {
+    return index >= capacity_;
+}
+
+inline bool ThreadPool::isCompensationNeeded(size_t index) const noexcept {
+    return blocked_.load(std::memory_order_seq_cst) > index - capacity_;
+}
+
+inline bool ThreadPool::enterBlocking() {
+    if (blocking_) {
+        return false;
+    }
+
+    blocking_ = true;
+
+    // blocked worker would hold its next task until region ends
+    flushNext();
+
+    const size_t blocked = blocked_.fetch_add(1, std::memory_order_seq_cst);
+
+    if (blocked >= options_.compensationLimit) {
+        return true;
+    }
+
+    std::lock_guard lock(growMutex_);
+
+    if (stop_.load(std::memory_order_acquire)) {
+        return true;
+    }
+
+    // worker still running at slot sees new blocked count before it retires
+    const size_t index = capacity_ + blocked;
+    bool expected = false;
+
+    if (!workers_[index].active.compare_exchange_strong(expected, true, std::memory_order_seq_cst)) {
+        return true;
+    }
+
+    try {
+        start(index);
+    }
+    catch (...) {
+        // blocked worker is left without compensation
+    }
+
+    return true;
+}
+
+inline void ThreadPool::leaveBlocking() {
+    blocking_ = false;
+    blocked_.fetch_sub(1, std::memory_order_seq_cst);
+
+    // parked compensation worker checks its slot under mutex
+    notifyWaiters();
+}
+
+inline bool ThreadPool::spin() const {
+    // full next slot is work too, its task is aged and stolen by pop, so blocked owner does not hold it
+    auto ready = [this] {
+        return stop_.load(std::memory_order_relaxed) || pending_.load(std::memory_order_relaxed) > 0 ||
+               (next_ && nextCount_.load(std::memory_order_relaxed) != 0);
+    };
+
+    for (size_t i = 0; i < options_.spinCount; ++i) {
+        if (ready()) {
+            return true;
+        }
+
+        details::cpuPause();
+    }
+
+    for (size_t i = 0; i < options_.yieldCount; ++i) {
+        if (ready()) {
+            return true;
+        }
+
+        std::this_thread::yield();
+    }
+
+    return ready();
+}
+
+inline bool ThreadPool::tryStartSpinning() {
+    const size_t maxSpinning = std::thread::hardware_concurrency() / 2;
+    size_t spinning = spinning_.load(std::memory_order_relaxed);
+
+    do {
+        if (spinning >= maxSpinning) {
+            return false;
+        }
+    }
+    while (!spinning_.compare_exchange_weak(spinning, spinning + 1, std::memory_order_relaxed));
+
+    return true;
+}
+
+inline bool ThreadPool::waitForTasks(size_t index) {
+    if (index < options_.hotWorkers) {
+        while (!spin()) {}
+        return !stop_.load(std::memory_order_acquire);
+    }
+
+    if (options_.idle == IdlePolicy::SpinThenPark && tryStartSpinning()) {
+        const bool ready = spin();
+        spinning_.fetch_sub(1, std::memory_order_relaxed);
+
+        if (ready) {
+            return !stop_.load(std::memory_order_acquire);
+        }
+    }
+
+    return park(index);
+}
+
+inline void ThreadPool::run(size_t index, Task& task) {
+#ifdef CS_THREAD_POOL_METRICS
+    using Clock = details::MetricsClock;
+
+    auto& metrics = metrics_[index];
+    const auto start = Clock::now();
+
+    metrics.waitTime.add(start - task.enqueued());
+
+    task();
+
+    const auto duration = Clock::now() - start;
+
+    metrics.executionTime.add(duration);
+    metrics.busyTime.add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    metrics.tasks.add(1);
+#else
+    (void)index;
+    task();
+#endif
+}
+
+inline void ThreadPool::routine(size_t index) {
+    current_ = this;
+    currentIndex_ = index;
+
+    // placement is a hint, rejected processors leave worker unpinned
+    if (!placements_[index].empty()) {
+        details::pinCurrentThread(placements_[index]);
+    }
+
+    for (;;) {
+        if (stop_.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        if (isCompensation(index) && !isCompensationNeeded(index) && retire(index)) {
+            break;
+        }
+
+        Task task;
+
+        if (pop(index, task)) {
+            // producers see worker idle until it leaves park, so they could notify it
+            // instead of growing pool, backlog left behind is picked up here
+            grow(1);
+            run(index, task);
+            continue;
+        }
+
+#ifdef CS_THREAD_POOL_METRICS
+        const auto idleStart = details::MetricsClock::now();
+        const bool running = waitForTasks(index);
+        const auto idleTime = details::MetricsClock::now() - idleStart;
+
+        metrics_[index].idleTime.add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(idleTime).count()));
+#else
+        const bool running = waitForTasks(index);
+#endif
+
+        if (!running) {
+            break;
+        }
     }
 }
 }
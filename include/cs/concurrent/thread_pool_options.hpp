@@ -0,0 +1,109 @@
+#ifndef CS_THREAD_POOL_OPTIONS_HPP
+#define CS_THREAD_POOL_OPTIONS_HPP
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+namespace cs {
+// defines how thread pool distributes tasks between workers
+enum class SchedulePolicy : unsigned char {
+    // all workers share one queue
+    SharedQueue,
+
+    // every worker owns a deque, external tasks go through injection queue
+    // and idle workers steal from others
+    WorkStealing,
+
+    // all workers share lock free bounded ring
+    LockFree
+};
+
+// defines enqueue behaviour when bounded queue is full
+enum class OverflowPolicy : unsigned char {
+    // enqueue throws exception
+    Fail,
+
+    // enqueue spins until queue has free slot
+    Spin,
+
+    // enqueue blocks until queue has free slot
+    Block
+};
+
+// defines how worker without tasks waits for new ones
+enum class IdlePolicy : unsigned char {
+    // worker sleeps at once and is woken up by producer
+    Park,
+
+    // worker spins with pause instructions, then yields, then sleeps,
+    // so task burst after short pause does not pay wake up latency,
+    // at most half of hardware threads spin at once
+    SpinThenPark
+};
+
+// task lane of ThreadPool, high tasks run before normal ones and low tasks after them
+enum class TaskPriority : unsigned char {
+    High,
+    Normal,
+    Low
+};
+
+// defines how workers are placed on processors
+enum class AffinityPolicy : unsigned char {
+    // workers are not pinned, os migrates them freely
+    None,
+
+    // worker is pinned to processor set of cpuSets at its index modulo sets count
+    Explicit,
+
+    // every worker is pinned to one processor, workers are spread over cache and numa domains,
+    // so consecutive workers land at different domains
+    Topology
+};
+
+struct ThreadPoolOptions {
+    size_t threadsCount = std::thread::hardware_concurrency();
+    SchedulePolicy schedule = SchedulePolicy::SharedQueue;
+
+    // lock free ring capacity, used only by SchedulePolicy::LockFree
+    size_t capacity = 65536;
+    OverflowPolicy overflow = OverflowPolicy::Block;
+
+    // idle worker behaviour, spin and yield counts are used by SpinThenPark policy and hot workers
+    IdlePolicy idle = IdlePolicy::Park;
+    size_t spinCount = 1024;
+    size_t yieldCount = 16;
+
+    // count of workers which never sleep, they spin and yield while pool is running
+    size_t hotWorkers = 0;
+
+    // elastic pool starts workers up to maxThreadsCount while tasks are queued and all workers are busy,
+    // workers above threadsCount retire after idleTimeout without tasks, zero means fixed size pool
+    size_t maxThreadsCount = 0;
+    std::chrono::milliseconds idleTimeout = std::chrono::seconds(60);
+
+    // count of extra workers started for workers blocked at BlockingRegion, every blocked worker
+    // gets one while count allows, extra worker exits when region ends, zero disables compensation
+    size_t compensationLimit = 0;
+
+    // task enqueued by worker of pool goes to worker next task slot and runs right after current task
+    // at the same worker while its data is still at cache, task pushed out of slot goes to queue,
+    // so nested tasks run in lifo order before tasks queued earlier, other workers take slot task
+    // of busy or blocked owner only after nextTaskAge (100 us) and before their queued tasks,
+    // elastic pool without free worker queues task to start new worker
+    bool nextTaskSlot = false;
+
+    // count of tasks taken from higher priority lanes or next task slot in a row while lower lane waits,
+    // then one task of lower lane is taken, so low and normal tasks are never starved
+    size_t starvationLimit = 16;
+
+    // worker placement, work stealing workers steal from workers of own domain first,
+    // domain of explicit set is domain of its first processor
+    AffinityPolicy affinity = AffinityPolicy::None;
+    std::vector<std::vector<unsigned>> cpuSets;
+};
+}
+
+#endif // CS_THREAD_POOL_OPTIONS_HPP
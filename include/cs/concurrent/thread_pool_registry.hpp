@@ -0,0 +1,192 @@
+#ifndef CS_THREAD_POOL_REGISTRY_HPP
+#define CS_THREAD_POOL_REGISTRY_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace cs {
+// pool of RunPolicy::Compute, bound to ThreadPool::instance until it is configured
+constexpr const char* computePool = "compute";
+
+// elastic pool of RunPolicy::Blocking for io and other waiting tasks
+constexpr const char* blockingPool = "blocking";
+
+// maximal threads count of default blocking pool
+constexpr size_t blockingPoolSize = 256;
+
+// named thread pools, pool is created by its options at first use, so it should be configured before,
+// tasks enqueued by registry go to priority lane of pool entry
+class ThreadPoolRegistry {
+public:
+    static ThreadPoolRegistry& instance() {
+        static ThreadPoolRegistry registry;
+        return registry;
+    }
+
+    ThreadPoolRegistry(const ThreadPoolRegistry&) = delete;
+    ThreadPoolRegistry& operator=(const ThreadPoolRegistry&) = delete;
+
+    // adds pool or replaces options of pool which was not used yet,
+    // throws std::logic_error if pool is running already
+    void configure(const std::string& name, const ThreadPoolOptions& options, TaskPriority priority = TaskPriority::Normal) {
+        std::lock_guard lock(mutex_);
+        auto& entry = unusedEntry(name);
+
+        entry.options = options;
+        entry.priority = priority;
+        entry.global = false;
+    }
+
+    // adds pool owned by caller, pool should outlive all its users,
+    // throws std::logic_error if pool with such name is running already
+    void add(const std::string& name, ThreadPool& pool, TaskPriority priority = TaskPriority::Normal) {
+        std::lock_guard lock(mutex_);
+        auto& entry = unusedEntry(name);
+
+        entry.priority = priority;
+        entry.global = false;
+        entry.pool.store(&pool, std::memory_order_release);
+    }
+
+    bool contains(const std::string& name) const {
+        std::lock_guard lock(mutex_);
+        return entries_.find(name) != entries_.end();
+    }
+
+    // returns pool by name starting it at first call, throws std::out_of_range for unknown name
+    ThreadPool& get(const std::string& name) {
+        return pool(entry(name));
+    }
+
+    // returns priority lane of registry tasks, throws std::out_of_range for unknown name
+    TaskPriority priority(const std::string& name) {
+        std::lock_guard lock(mutex_);
+        return find(name).priority;
+    }
+
+    // enqueues task to named pool by pool entry priority
+    template <typename Func>
+    void enqueue(const std::string& name, Func&& func) {
+        enqueue(entry(name), std::forward<Func>(func));
+    }
+
+    // entries of run policies are cached, so policy dispatch does not look up names
+    ThreadPool& compute() {
+        return pool(*compute_);
+    }
+
+    ThreadPool& blocking() {
+        return pool(*blocking_);
+    }
+
+    template <typename Func>
+    void enqueueCompute(Func&& func) {
+        enqueue(*compute_, std::forward<Func>(func));
+    }
+
+    template <typename Func>
+    void enqueueBlocking(Func&& func) {
+        enqueue(*blocking_, std::forward<Func>(func));
+    }
+
+private:
+    // priority and options are not changed after pool is set, so they are read without lock then
+    struct Entry {
+        ThreadPoolOptions options;
+        TaskPriority priority = TaskPriority::Normal;
+
+        // entry uses ThreadPool::instance
+        bool global = false;
+
+        std::unique_ptr<ThreadPool> owned;
+        std::atomic<ThreadPool*> pool = { nullptr };
+    };
+
+    ThreadPoolRegistry() {
+        auto& compute = entries_[computePool];
+        compute.global = true;
+
+        auto& blocking = entries_[blockingPool];
+        blocking.options.threadsCount = 0;
+        blocking.options.maxThreadsCount = blockingPoolSize;
+        blocking.options.idleTimeout = std::chrono::seconds(60);
+        blocking.options.nextTaskSlot = false;
+
+        // map nodes are stable
+        compute_ = &compute;
+        blocking_ = &blocking;
+    }
+
+    Entry& find(const std::string& name) {
+        auto iter = entries_.find(name);
+
+        if (iter == entries_.end()) {
+            throw std::out_of_range("ThreadPoolRegistry has no pool " + name);
+        }
+
+        return iter->second;
+    }
+
+    Entry& entry(const std::string& name) {
+        std::lock_guard lock(mutex_);
+        return find(name);
+    }
+
+    Entry& unusedEntry(const std::string& name) {
+        auto& entry = entries_[name];
+
+        if (entry.pool.load(std::memory_order_acquire) != nullptr) {
+            throw std::logic_error("ThreadPoolRegistry pool " + name + " is running already");
+        }
+
+        return entry;
+    }
+
+    ThreadPool& pool(Entry& entry) {
+        if (auto pool = entry.pool.load(std::memory_order_acquire); pool) {
+            return *pool;
+        }
+
+        std::lock_guard lock(mutex_);
+
+        if (entry.pool.load(std::memory_order_relaxed) == nullptr) {
+            if (entry.global) {
+                entry.pool.store(&ThreadPool::instance(), std::memory_order_release);
+            }
+            else {
+                entry.owned = std::make_unique<ThreadPool>(entry.options);
+                entry.pool.store(entry.owned.get(), std::memory_order_release);
+            }
+        }
+
+        return *entry.pool.load(std::memory_order_relaxed);
+    }
+
+    template <typename Func>
+    void enqueue(Entry& entry, Func&& func) {
+        auto& target = pool(entry);
+
+        if (entry.priority == TaskPriority::Normal) {
+            target.enqueue(std::forward<Func>(func));
+        }
+        else {
+            target.enqueue(entry.priority, std::forward<Func>(func));
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+
+    Entry* compute_ = nullptr;
+    Entry* blocking_ = nullptr;
+};
+}
+
+#endif // CS_THREAD_POOL_REGISTRY_HPP
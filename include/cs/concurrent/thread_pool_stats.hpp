@@ -0,0 +1,199 @@
+#ifndef CS_THREAD_POOL_STATS_HPP
+#define CS_THREAD_POOL_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include <cs/utils/cache.hpp>
+#include <cs/concurrent/task.hpp>
+
+// define CS_THREAD_POOL_METRICS for all translation units to collect ThreadPool metrics,
+// without it collection code is not compiled and stats contain only gauges
+
+namespace cs {
+// log2 histogram of durations, bucket i counts durations at [2^(i - 1), 2^i) nanoseconds,
+// first bucket counts zero durations
+struct LatencyHistogram {
+    constexpr static size_t bucketsCount = 40;
+
+    std::array<uint64_t, bucketsCount> buckets = {};
+
+    uint64_t count() const noexcept {
+        uint64_t result = 0;
+
+        for (auto value : buckets) {
+            result += value;
+        }
+
+        return result;
+    }
+
+    // returns upper bound of bucket which contains rank part of values
+    std::chrono::nanoseconds percentile(double rank) const noexcept {
+        const auto total = count();
+
+        if (total == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+
+        const auto target = static_cast<uint64_t>(rank * static_cast<double>(total - 1)) + 1;
+        uint64_t accumulated = 0;
+
+        for (size_t i = 0; i < bucketsCount; ++i) {
+            accumulated += buckets[i];
+
+            if (accumulated >= target) {
+                return std::chrono::nanoseconds(i == 0 ? 0 : (int64_t(1) << i));
+            }
+        }
+
+        return std::chrono::nanoseconds(int64_t(1) << (bucketsCount - 1));
+    }
+
+    void merge(const LatencyHistogram& histogram) noexcept {
+        for (size_t i = 0; i < bucketsCount; ++i) {
+            buckets[i] += histogram.buckets[i];
+        }
+    }
+};
+
+struct WorkerStats {
+    bool active = false;
+
+    uint64_t tasks = 0;
+    uint64_t steals = 0;
+
+    std::chrono::nanoseconds busyTime{0};
+    std::chrono::nanoseconds idleTime{0};
+
+    // enqueue to start time and execution time of worker tasks
+    LatencyHistogram waitTime;
+    LatencyHistogram executionTime;
+};
+
+// snapshot of pool state, counters of different workers are read independently
+struct ThreadPoolStats {
+    // false if metrics are compiled out, worker stats are empty then
+    bool enabled = false;
+
+    size_t queueDepth = 0;
+    size_t workersCount = 0;
+    size_t idleWorkers = 0;
+
+    // stats of every worker slot
+    std::vector<WorkerStats> workers;
+
+    // sum of all workers histograms
+    LatencyHistogram waitTime;
+    LatencyHistogram executionTime;
+};
+
+namespace details {
+#ifdef CS_THREAD_POOL_METRICS
+using MetricsClock = std::chrono::steady_clock;
+
+// counter with one writer, so increment is plain load and store without locked instruction
+class MetricsCounter {
+public:
+    void add(uint64_t value) noexcept {
+        value_.store(value_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    uint64_t load() const noexcept {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> value_ = { 0 };
+};
+
+class HistogramCounter {
+public:
+    void add(MetricsClock::duration duration) noexcept {
+        const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        buckets_[bucket(nanoseconds > 0 ? static_cast<uint64_t>(nanoseconds) : 0)].add(1);
+    }
+
+    LatencyHistogram load() const noexcept {
+        LatencyHistogram histogram;
+
+        for (size_t i = 0; i < LatencyHistogram::bucketsCount; ++i) {
+            histogram.buckets[i] = buckets_[i].load();
+        }
+
+        return histogram;
+    }
+
+private:
+    static size_t bucket(uint64_t value) noexcept {
+        if (value == 0) {
+            return 0;
+        }
+
+#if defined(__GNUC__) || defined(__clang__)
+        const size_t index = 64 - static_cast<size_t>(__builtin_clzll(value));
+#else
+        size_t index = 0;
+
+        while (value != 0) {
+            value >>= 1;
+            ++index;
+        }
+#endif
+
+        return index < LatencyHistogram::bucketsCount ? index : LatencyHistogram::bucketsCount - 1;
+    }
+
+    std::array<MetricsCounter, LatencyHistogram::bucketsCount> buckets_;
+};
+
+// counters of one worker slot, written only by slot worker
+struct cacheline_aligned WorkerMetrics {
+    MetricsCounter tasks;
+    MetricsCounter steals;
+    MetricsCounter busyTime;
+    MetricsCounter idleTime;
+
+    HistogramCounter waitTime;
+    HistogramCounter executionTime;
+};
+
+// pool task with enqueue time
+class TimedTask {
+public:
+    TimedTask() = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, TimedTask>>>
+    TimedTask(F&& func):
+        task_(std::forward<F>(func)), enqueued_(MetricsClock::now()) {}
+
+    void operator()() {
+        task_();
+    }
+
+    explicit operator bool() const noexcept {
+        return static_cast<bool>(task_);
+    }
+
+    MetricsClock::time_point enqueued() const noexcept {
+        return enqueued_;
+    }
+
+private:
+    Task task_;
+    MetricsClock::time_point enqueued_;
+};
+
+using PoolTask = TimedTask;
+#else
+using PoolTask = Task;
+#endif
+}
+}
+
+#endif // CS_THREAD_POOL_STATS_HPP
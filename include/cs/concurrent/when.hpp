@@ -0,0 +1,210 @@
+#ifndef CS_WHEN_HPP
+#define CS_WHEN_HPP
+
+#include <tuple>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <variant>
+#include <stdexcept>
+#include <type_traits>
+
+#include <cs/concurrent/future_watcher.hpp>
+
+namespace cs {
+// value of watcher result at combined results, void result is std::monostate
+template <typename Result>
+using WhenValue = std::conditional_t<std::is_void_v<Result>, std::monostate, Result>;
+
+namespace details {
+// combined watchers are completed by completion callbacks of their children,
+// callbacks keep combined watcher alive until the last child is completed
+class WatcherCombinators {
+public:
+    template <typename Result>
+    static FutureWatcherPtr<std::conditional_t<std::is_void_v<Result>, void, std::vector<Result>>> whenAll(const std::vector<FutureWatcherPtr<Result>>& watchers) {
+        using Values = std::conditional_t<std::is_void_v<Result>, void, std::vector<Result>>;
+
+        auto next = combined<Values>(watchers.empty() ? RunPolicy::ThreadPool : watchers.front()->policy_);
+        auto state = std::make_shared<State>(watchers.size());
+
+        auto complete = [next, watchers] {
+            if constexpr (std::is_void_v<Result>) {
+                next->setResult();
+            }
+            else {
+                std::vector<Result> values;
+                values.reserve(watchers.size());
+
+                for (const auto& watcher : watchers) {
+                    values.push_back(*watcher->result_);
+                }
+
+                next->setResult(std::move(values));
+            }
+        };
+
+        if (watchers.empty()) {
+            complete();
+            return next;
+        }
+
+        for (const auto& watcher : watchers) {
+            onCompleted(watcher, [watcher = watcher.get(), next, state, complete] {
+                all(*watcher, *next, *state, complete);
+            });
+        }
+
+        return next;
+    }
+
+    template <typename... Results>
+    static FutureWatcherPtr<std::tuple<WhenValue<Results>...>> whenAll(const FutureWatcherPtr<Results>&... watchers) {
+        using Values = std::tuple<WhenValue<Results>...>;
+
+        auto next = combined<Values>(std::get<0>(std::tie(watchers...))->policy_);
+        auto state = std::make_shared<State>(sizeof...(Results));
+
+        auto complete = [next, watchers...] {
+            next->setResult(Values(value(*watchers)...));
+        };
+
+        (onCompleted(watchers, [watcher = watchers.get(), next, state, complete] {
+            all(*watcher, *next, *state, complete);
+        }), ...);
+
+        return next;
+    }
+
+    template <typename Result>
+    static FutureWatcherPtr<std::conditional_t<std::is_void_v<Result>, size_t, std::pair<size_t, Result>>> whenAny(const std::vector<FutureWatcherPtr<Result>>& watchers) {
+        using Value = std::conditional_t<std::is_void_v<Result>, size_t, std::pair<size_t, Result>>;
+
+        auto next = combined<Value>(watchers.empty() ? RunPolicy::ThreadPool : watchers.front()->policy_);
+
+        if (watchers.empty()) {
+            try {
+                throw std::invalid_argument("whenAny of empty watchers list");
+            }
+            catch (const std::exception& e) {
+                next->setFailed(std::current_exception(), e.what());
+            }
+
+            return next;
+        }
+
+        auto state = std::make_shared<State>(watchers.size());
+
+        for (size_t i = 0; i < watchers.size(); ++i) {
+            onCompleted(watchers[i], [index = i, watcher = watchers[i].get(), next, state] {
+                if (state->done.exchange(true, std::memory_order_acq_rel)) {
+                    return;
+                }
+
+                if (!isSucceeded(*watcher)) {
+                    next->setFailed(*watcher);
+                }
+                else if constexpr (std::is_void_v<Result>) {
+                    next->setResult(size_t(index));
+                }
+                else {
+                    next->setResult(Value(index, *watcher->result_));
+                }
+            });
+        }
+
+        return next;
+    }
+
+private:
+    struct State {
+        explicit State(size_t count):
+            remaining(count) {}
+
+        std::atomic<size_t> remaining;
+        std::atomic<bool> done = { false };
+    };
+
+    template <typename Result>
+    static FutureWatcherPtr<Result> combined(RunPolicy policy) {
+        auto watcher = std::make_shared<FutureWatcher<Result>>(policy);
+        watcher->state_ = WatcherState::Running;
+
+        return watcher;
+    }
+
+    // callback is called by child task thread or at once if child is completed already,
+    // child pointer is kept by callback owner, so callbacks capture raw child pointer
+    template <typename Result, typename Func>
+    static void onCompleted(const FutureWatcherPtr<Result>& watcher, Func&& func) {
+        Task callback(std::forward<Func>(func));
+
+        if (!watcher->addCompletionCallback(std::move(callback))) {
+            callback();
+        }
+    }
+
+    // first failed child fails combined watcher, the last succeeded one completes it
+    template <typename Result, typename Next, typename Func>
+    static void all(const FutureWatcher<Result>& watcher, FutureWatcher<Next>& next, State& state, const Func& complete) {
+        if (!isSucceeded(watcher)) {
+            if (!state.done.exchange(true, std::memory_order_acq_rel)) {
+                next.setFailed(watcher);
+            }
+        }
+        else if (state.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 && !state.done.exchange(true, std::memory_order_acq_rel)) {
+            complete();
+        }
+    }
+
+    template <typename Result>
+    static bool isSucceeded(const FutureWatcher<Result>& watcher) {
+        if constexpr (std::is_void_v<Result>) {
+            return watcher.succeeded_;
+        }
+        else {
+            return watcher.result_.has_value();
+        }
+    }
+
+    template <typename Result>
+    static WhenValue<Result> value(const FutureWatcher<Result>& watcher) {
+        if constexpr (std::is_void_v<Result>) {
+            return std::monostate();
+        }
+        else {
+            return *watcher.result_;
+        }
+    }
+};
+}
+
+// returns watcher finished with results of all watchers in their order after the last of them is finished,
+// it fails or is cancelled at once by the first failed or cancelled watcher
+template <typename Result>
+auto whenAll(const std::vector<FutureWatcherPtr<Result>>& watchers) {
+    return details::WatcherCombinators::whenAll(watchers);
+}
+
+// returns watcher finished with tuple of results, void results are std::monostate
+template <typename Result, typename... Results>
+auto whenAll(const FutureWatcherPtr<Result>& watcher, const FutureWatcherPtr<Results>&... watchers) {
+    return details::WatcherCombinators::whenAll(watcher, watchers...);
+}
+
+// returns watcher completed by the first completed watcher, result is index of watcher and its result
+// or only index for void watchers, failure or cancellation of the first watcher is passed too
+template <typename Result>
+auto whenAny(const std::vector<FutureWatcherPtr<Result>>& watchers) {
+    return details::WatcherCombinators::whenAny(watchers);
+}
+
+template <typename Result, typename... Results>
+auto whenAny(const FutureWatcherPtr<Result>& watcher, const FutureWatcherPtr<Results>&... watchers) {
+    static_assert((std::is_same_v<Result, Results> && ...), "whenAny watchers should have the same result type");
+    return details::WatcherCombinators::whenAny(std::vector<FutureWatcherPtr<Result>>{ watcher, watchers... });
+}
+}
+
+#endif // CS_WHEN_HPP
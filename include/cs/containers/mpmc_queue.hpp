@@ -0,0 +1,241 @@
+#ifndef CS_MPMC_QUEUE_HPP
+#define CS_MPMC_QUEUE_HPP
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <type_traits>
+
+#include <cs/utils/cache.hpp>
+
+namespace cs {
+// lock free bounded multi producer multi consumer queue,
+// every slot has sequence number to define is it ready for push or pop,
+// claimed slot could not be given back, so nothing that could throw runs between claim and release of slot
+template <typename T>
+class MpmcQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "MpmcQueue value should be nothrow move constructible");
+
+public:
+    using value_type = T;
+
+    // capacity is rounded up to power of two
+    explicit MpmcQueue(size_t capacity);
+    ~MpmcQueue();
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // constructs value at queue, returns false if queue is full,
+    // arguments are not touched in this case if T is nothrow constructible from them,
+    // otherwise value is constructed before slot is claimed and is moved to it
+    template <typename... Args>
+    bool tryEmplace(Args&&... args);
+
+    bool tryPush(const T& value);
+    bool tryPush(T&& value);
+
+    // moves front value to argument, returns false if queue is empty
+    bool tryPop(T& value);
+
+    // constructs front value at empty optional, so T needs no default constructor or assignment
+    bool tryPop(std::optional<T>& value);
+
+    size_t capacity() const noexcept;
+
+    // approximate values, queue could be changed by other threads at any moment
+    size_t size() const noexcept;
+    bool isEmpty() const noexcept;
+    bool isFull() const noexcept;
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    static size_t roundCapacity(size_t capacity) noexcept;
+
+    // passes front value as rvalue to consume before it is destroyed at slot,
+    // throwing consume gets value moved out of already released slot
+    template <typename Consume>
+    bool popWith(Consume&& consume);
+
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // consumers pop at head, producers push at tail
+    cacheline_aligned std::atomic<size_t> head_ = { 0 };
+    cacheline_aligned std::atomic<size_t> tail_ = { 0 };
+};
+
+template <typename T>
+inline MpmcQueue<T>::MpmcQueue(size_t capacity):
+    mask_(roundCapacity(capacity) - 1),
+    slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+    for (size_t i = 0; i <= mask_; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+inline MpmcQueue<T>::~MpmcQueue() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+
+        for (size_t position = head_.load(std::memory_order_acquire); position != tail; ++position) {
+            auto& slot = slots_[position & mask_];
+
+            if (slot.sequence.load(std::memory_order_acquire) == position + 1) {
+                slot.value()->~T();
+            }
+        }
+    }
+}
+
+template <typename T>
+template <typename... Args>
+inline bool MpmcQueue<T>::tryEmplace(Args&&... args) {
+    if constexpr (!std::is_nothrow_constructible_v<T, Args&&...>) {
+        return tryEmplace(T(std::forward<Args>(args)...));
+    }
+
+    size_t position = tail_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    for (;;) {
+        slot = &slots_[position & mask_];
+
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+        if (difference == 0) {
+            if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (difference < 0) {
+            return false;
+        }
+        else {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (slot->storage) T(std::forward<Args>(args)...);
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+inline bool MpmcQueue<T>::tryPush(const T& value) {
+    return tryEmplace(value);
+}
+
+template <typename T>
+inline bool MpmcQueue<T>::tryPush(T&& value) {
+    return tryEmplace(std::move(value));
+}
+
+template <typename T>
+inline bool MpmcQueue<T>::tryPop(T& value) {
+    return popWith([&value](T&& element) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        value = std::move(element);
+    });
+}
+
+template <typename T>
+inline bool MpmcQueue<T>::tryPop(std::optional<T>& value) {
+    return popWith([&value](T&& element) noexcept {
+        value.emplace(std::move(element));
+    });
+}
+
+template <typename T>
+template <typename Consume>
+inline bool MpmcQueue<T>::popWith(Consume&& consume) {
+    size_t position = head_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    for (;;) {
+        slot = &slots_[position & mask_];
+
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+
+        if (difference == 0) {
+            if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (difference < 0) {
+            return false;
+        }
+        else {
+            position = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    T* element = slot->value();
+
+    if constexpr (std::is_nothrow_invocable_v<Consume, T&&>) {
+        consume(std::move(*element));
+        element->~T();
+
+        slot->sequence.store(position + mask_ + 1, std::memory_order_release);
+    }
+    else {
+        T value(std::move(*element));
+        element->~T();
+
+        slot->sequence.store(position + mask_ + 1, std::memory_order_release);
+        consume(std::move(value));
+    }
+
+    return true;
+}
+
+template <typename T>
+inline size_t MpmcQueue<T>::capacity() const noexcept {
+    return mask_ + 1;
+}
+
+template <typename T>
+inline size_t MpmcQueue<T>::size() const noexcept {
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+
+    return tail > head ? tail - head : 0;
+}
+
+template <typename T>
+inline bool MpmcQueue<T>::isEmpty() const noexcept {
+    return size() == 0;
+}
+
+template <typename T>
+inline bool MpmcQueue<T>::isFull() const noexcept {
+    return size() >= capacity();
+}
+
+template <typename T>
+inline size_t MpmcQueue<T>::roundCapacity(size_t capacity) noexcept {
+    size_t result = 2;
+
+    while (result < capacity) {
+        result <<= 1;
+    }
+
+    return result;
+}
+}
+
+#endif // CS_MPMC_QUEUE_HPP
@@ -0,0 +1,193 @@
+#ifndef CS_SPSC_QUEUE_HPP
+#define CS_SPSC_QUEUE_HPP
+
+#include <new>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <type_traits>
+
+#include <cs/utils/cache.hpp>
+
+namespace cs {
+// wait free bounded single producer single consumer ring,
+// every side caches index of other side and reloads it only when ring looks full or empty
+// warn: only one thread should push and only one thread should pop at a time
+template <typename T>
+class SpscQueue {
+public:
+    using value_type = T;
+
+    // capacity is rounded up to power of two
+    explicit SpscQueue(size_t capacity);
+    ~SpscQueue();
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // constructs value at queue, returns false if queue is full,
+    // arguments are not touched in this case
+    template <typename... Args>
+    bool tryEmplace(Args&&... args);
+
+    bool tryPush(const T& value);
+    bool tryPush(T&& value);
+
+    // moves front value to argument, returns false if queue is empty
+    bool tryPop(T& value);
+
+    // constructs front value at empty optional, so T needs no default constructor or assignment
+    bool tryPop(std::optional<T>& value);
+
+    size_t capacity() const noexcept;
+
+    // approximate values, queue could be changed by other side at any moment
+    size_t size() const noexcept;
+    bool isEmpty() const noexcept;
+    bool isFull() const noexcept;
+
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    static size_t roundCapacity(size_t capacity) noexcept;
+
+    // passes front value as rvalue to consume before it is destroyed at slot
+    template <typename Consume>
+    bool popWith(Consume&& consume);
+
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // consumer pops at head, producer pushes at tail
+    cacheline_aligned std::atomic<size_t> head_ = { 0 };
+    size_t cachedTail_ = 0;
+
+    cacheline_aligned std::atomic<size_t> tail_ = { 0 };
+    size_t cachedHead_ = 0;
+};
+
+template <typename T>
+inline SpscQueue<T>::SpscQueue(size_t capacity):
+    mask_(roundCapacity(capacity) - 1),
+    slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+}
+
+template <typename T>
+inline SpscQueue<T>::~SpscQueue() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+
+        for (size_t position = head_.load(std::memory_order_acquire); position != tail; ++position) {
+            slots_[position & mask_].value()->~T();
+        }
+    }
+}
+
+template <typename T>
+template <typename... Args>
+inline bool SpscQueue<T>::tryEmplace(Args&&... args) {
+    const size_t position = tail_.load(std::memory_order_relaxed);
+
+    if (position - cachedHead_ > mask_) {
+        cachedHead_ = head_.load(std::memory_order_acquire);
+
+        if (position - cachedHead_ > mask_) {
+            return false;
+        }
+    }
+
+    new (slots_[position & mask_].storage) T(std::forward<Args>(args)...);
+    tail_.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+inline bool SpscQueue<T>::tryPush(const T& value) {
+    return tryEmplace(value);
+}
+
+template <typename T>
+inline bool SpscQueue<T>::tryPush(T&& value) {
+    return tryEmplace(std::move(value));
+}
+
+template <typename T>
+inline bool SpscQueue<T>::tryPop(T& value) {
+    return popWith([&value](T&& element) {
+        value = std::move(element);
+    });
+}
+
+template <typename T>
+inline bool SpscQueue<T>::tryPop(std::optional<T>& value) {
+    return popWith([&value](T&& element) {
+        value.emplace(std::move(element));
+    });
+}
+
+template <typename T>
+template <typename Consume>
+inline bool SpscQueue<T>::popWith(Consume&& consume) {
+    const size_t position = head_.load(std::memory_order_relaxed);
+
+    if (position == cachedTail_) {
+        cachedTail_ = tail_.load(std::memory_order_acquire);
+
+        if (position == cachedTail_) {
+            return false;
+        }
+    }
+
+    T* element = slots_[position & mask_].value();
+    consume(std::move(*element));
+    element->~T();
+
+    head_.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+inline size_t SpscQueue<T>::capacity() const noexcept {
+    return mask_ + 1;
+}
+
+template <typename T>
+inline size_t SpscQueue<T>::size() const noexcept {
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+
+    return tail > head ? tail - head : 0;
+}
+
+template <typename T>
+inline bool SpscQueue<T>::isEmpty() const noexcept {
+    return size() == 0;
+}
+
+template <typename T>
+inline bool SpscQueue<T>::isFull() const noexcept {
+    return size() >= capacity();
+}
+
+template <typename T>
+inline size_t SpscQueue<T>::roundCapacity(size_t capacity) noexcept {
+    size_t result = 2;
+
+    while (result < capacity) {
+        result <<= 1;
+    }
+
+    return result;
+}
+}
+
+#endif // CS_SPSC_QUEUE_HPP
@@ -33,6 +33,7 @@
 #endif
 
 #include <cs/signals/signals.hpp>
+#include <cs/concurrent/thread_pool.hpp>
 #include <cs/process/details/process_exception.hpp>
 
 namespace cs {
@@ -196,6 +197,9 @@ inline bool Process::isPipeValid() const {
 }
 
 inline void Process::wait() {
+    // pool worker waiting for process is compensated by extra worker
+    BlockingRegion region;
+
     try {
         process_.wait();
         io_.stop();
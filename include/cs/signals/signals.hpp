@@ -96,7 +96,7 @@ public:
         (*this) = nullptr;
     }
 
-private:
+protected:
     // adds slot to signal
     template <typename T>
     auto& add(T&& s, details::ObjectPointer obj = nullptr) {
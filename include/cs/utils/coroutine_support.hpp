@@ -0,0 +1,12 @@
+#ifndef CS_COROUTINE_SUPPORT_HPP
+#define CS_COROUTINE_SUPPORT_HPP
+
+// coroutine api is available only when library is built as C++20
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define CS_COROUTINES_SUPPORTED
+#endif
+#endif
+
+#endif // CS_COROUTINE_SUPPORT_HPP
@@ -0,0 +1,101 @@
+#ifndef CS_FUTEX_HPP
+#define CS_FUTEX_HPP
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <ctime>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#else
+#include <mutex>
+#include <array>
+#include <functional>
+#include <condition_variable>
+#endif
+
+namespace cs::details {
+using FutexWord = std::atomic<uint32_t>;
+
+static_assert(sizeof(FutexWord) == sizeof(uint32_t), "Futex word should be plain 32 bit value");
+
+// wakes all threads waiting at word
+constexpr uint32_t futexWakeAll = static_cast<uint32_t>(std::numeric_limits<int>::max());
+
+#if defined(__linux__)
+// sleeps while word equals expected, negative timeout means no timeout,
+// returns false only if timeout is expired, wakeups could be spurious
+inline bool futexWait(FutexWord& word, uint32_t expected, std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1)) noexcept {
+    timespec spec{};
+    timespec* specPtr = nullptr;
+
+    if (timeout.count() >= 0) {
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+
+        spec.tv_sec = static_cast<time_t>(seconds.count());
+        spec.tv_nsec = static_cast<long>((timeout - seconds).count());
+        specPtr = &spec;
+    }
+
+    const auto result = syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, specPtr, nullptr, 0);
+    return result == 0 || errno != ETIMEDOUT;
+}
+
+// wakes up to count threads sleeping at word
+inline void futexWake(FutexWord& word, uint32_t count) noexcept {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, static_cast<int>(count), nullptr, nullptr, 0);
+}
+#else
+// portable fallback, words are hashed to buckets of mutex and condition variable,
+// bucket is shared by several words, so every wake notifies all its sleepers
+struct FutexBucket {
+    std::mutex mutex;
+    std::condition_variable notifier;
+};
+
+inline FutexBucket& futexBucket(const FutexWord& word) noexcept {
+    static std::array<FutexBucket, 64> buckets;
+    return buckets[std::hash<const void*>{}(&word) % buckets.size()];
+}
+
+inline bool futexWait(FutexWord& word, uint32_t expected, std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1)) {
+    auto& bucket = futexBucket(word);
+    std::unique_lock lock(bucket.mutex);
+
+    if (word.load(std::memory_order_seq_cst) != expected) {
+        return true;
+    }
+
+    if (timeout.count() < 0) {
+        bucket.notifier.wait(lock);
+        return true;
+    }
+
+    return bucket.notifier.wait_for(lock, timeout) == std::cv_status::no_timeout;
+}
+
+// waker changes word before wake, so bucket lock guarantees sleeper either saw new value or is notified
+inline void futexWake(FutexWord& word, uint32_t) {
+    auto& bucket = futexBucket(word);
+
+    {
+        std::lock_guard lock(bucket.mutex);
+    }
+
+    bucket.notifier.notify_all();
+}
+#endif
+
+// returns time left till deadline, zero if it is passed
+inline std::chrono::nanoseconds futexTimeout(std::chrono::steady_clock::time_point deadline) {
+    const auto now = std::chrono::steady_clock::now();
+    return now < deadline ? std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now) : std::chrono::nanoseconds(0);
+}
+}
+
+#endif // CS_FUTEX_HPP
@@ -0,0 +1,25 @@
+#ifndef CS_PAUSE_HPP
+#define CS_PAUSE_HPP
+
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace cs::details {
+// hints processor that thread is at spin wait loop
+inline void cpuPause() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::this_thread::yield();
+#endif
+}
+}
+
+#endif // CS_PAUSE_HPP
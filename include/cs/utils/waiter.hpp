@@ -1,13 +1,44 @@
 #ifndef CS_WAITER_HPP
 #define CS_WAITER_HPP
 
+#include <atomic>
 #include <chrono>
 #include <thread>
+#include <cstdint>
+#include <utility>
+
+#include <cs/utils/details/futex.hpp>
 
 namespace cs {
+// wakes threads sleeping at Waiter::wait with this notifier,
+// notify without sleeping threads costs two atomic operations
+class Notifier {
+public:
+    Notifier() = default;
+
+    Notifier(const Notifier&) = delete;
+    Notifier& operator=(const Notifier&) = delete;
+
+    // should be called after predicate state is changed, sleeping threads recheck their predicates
+    void notify() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+
+        if (sleepers_.load(std::memory_order_seq_cst) != 0) {
+            details::futexWake(epoch_, details::futexWakeAll);
+        }
+    }
+
+private:
+    details::FutexWord epoch_ = { 0 };
+    std::atomic<uint32_t> sleepers_ = { 0 };
+
+    friend class Waiter;
+};
+
 // waits predicate or some time
 class Waiter {
 public:
+    // polls predicate and yields between checks, so thread keeps its core busy
     template<typename Predicate>
     static void wait(Predicate&& predicate, const std::chrono::milliseconds ms) {
         const auto timePoint = std::chrono::steady_clock::now();
@@ -28,6 +59,37 @@ public:
     static void wait(Predicate&& predicate, const int ms) {
         cs::Waiter::wait(std::forward<Predicate>(predicate), std::chrono::milliseconds(ms));
     }
+
+    // sleeps while predicate is true and checks it again only when notifier is notified,
+    // returns false if time is out
+    template<typename Predicate>
+    static bool wait(Notifier& notifier, Predicate&& predicate, const std::chrono::milliseconds ms) {
+        const auto deadline = std::chrono::steady_clock::now() + ms;
+
+        for (;;) {
+            // epoch is read before predicate, so notify after the check fails futex wait at once
+            const uint32_t epoch = notifier.epoch_.load(std::memory_order_seq_cst);
+
+            if (!predicate()) {
+                return true;
+            }
+
+            const auto timeout = details::futexTimeout(deadline);
+
+            if (timeout.count() == 0) {
+                return false;
+            }
+
+            notifier.sleepers_.fetch_add(1, std::memory_order_seq_cst);
+            details::futexWait(notifier.epoch_, epoch, timeout);
+            notifier.sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    template<typename Predicate>
+    static bool wait(Notifier& notifier, Predicate&& predicate, const int ms) {
+        return cs::Waiter::wait(notifier, std::forward<Predicate>(predicate), std::chrono::milliseconds(ms));
+    }
 };
 }
 
@@ -0,0 +1,63 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/concurrent/parallel.hpp>
+#include <cs/concurrent/cpu_topology.hpp>
+
+namespace {
+// arrays are far larger than last level cache, so loop is bound by memory bandwidth
+constexpr size_t valuesCount = 4'000'000;
+constexpr size_t passesCount = 10;
+constexpr size_t grain = 16384;
+
+// stream triad over the same arrays every pass, pinned workers keep chunks they touched at own domain
+void triad(const std::string& name, cs::AffinityPolicy affinity) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = std::max(1u, std::thread::hardware_concurrency());
+    options.schedule = cs::SchedulePolicy::WorkStealing;
+    options.affinity = affinity;
+
+    cs::ThreadPool pool(options);
+
+    std::vector<double> a(valuesCount);
+    std::vector<double> b(valuesCount);
+    std::vector<double> c(valuesCount);
+
+    // first touch by pool workers places pages at their numa nodes
+    cs::parallelFor(pool, size_t(0), valuesCount, grain, [&](size_t index) {
+        a[index] = 0.0;
+        b[index] = 1.0;
+        c[index] = 2.0;
+    });
+
+    const auto duration = cs::testing::measure([&] {
+        for (size_t pass = 0; pass < passesCount; ++pass) {
+            cs::parallelFor(pool, size_t(0), valuesCount, grain, [&](size_t index) {
+                a[index] = b[index] + 3.0 * c[index];
+            });
+        }
+    });
+
+    ASSERT_EQ(a.front(), 7.0);
+    ASSERT_EQ(a.back(), 7.0);
+
+    cs::testing::report(name + ", " + std::to_string(options.threadsCount) + " threads, " +
+                        std::to_string(cs::CpuTopology::instance().domainsCount()) + " domains", valuesCount * passesCount, duration);
+}
+}
+
+TEST(AffinityBenchmark, TriadUnpinned) {
+    triad("Memory bound triad, unpinned workers", cs::AffinityPolicy::None);
+}
+
+TEST(AffinityBenchmark, TriadTopologyPinned) {
+    triad("Memory bound triad, workers pinned by topology", cs::AffinityPolicy::Topology);
+}
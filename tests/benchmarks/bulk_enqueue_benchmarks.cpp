@@ -0,0 +1,62 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+#include <functional>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace {
+template <typename Enqueue>
+void enqueueBenchmark(const std::string& name, size_t tasksCount, Enqueue&& enqueue) {
+    std::atomic<size_t> counter = { 0 };
+    std::vector<std::function<void()>> tasks(tasksCount, [&] {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    cs::ThreadPool pool(std::max(2u, std::thread::hardware_concurrency()));
+
+    const auto duration = cs::testing::measure([&] {
+        enqueue(pool, tasks);
+        cs::Waiter::wait([&] { return counter.load(std::memory_order_acquire) != tasksCount; }, 60000);
+    });
+
+    ASSERT_EQ(counter.load(), tasksCount);
+    cs::testing::report(name, tasksCount, duration);
+}
+
+void perTaskEnqueue(size_t tasksCount) {
+    enqueueBenchmark("ThreadPool per task enqueue", tasksCount, [](cs::ThreadPool& pool, std::vector<std::function<void()>>& tasks) {
+        for (auto& task : tasks) {
+            pool.enqueue(task);
+        }
+    });
+}
+
+void bulkEnqueue(size_t tasksCount) {
+    enqueueBenchmark("ThreadPool bulk enqueue", tasksCount, [](cs::ThreadPool& pool, std::vector<std::function<void()>>& tasks) {
+        pool.enqueueBulk(tasks.begin(), tasks.end());
+    });
+}
+}
+
+TEST(BulkEnqueueBenchmark, PerTask10k) {
+    perTaskEnqueue(10'000);
+}
+
+TEST(BulkEnqueueBenchmark, Bulk10k) {
+    bulkEnqueue(10'000);
+}
+
+TEST(BulkEnqueueBenchmark, PerTask1M) {
+    perTaskEnqueue(1'000'000);
+}
+
+TEST(BulkEnqueueBenchmark, Bulk1M) {
+    bulkEnqueue(1'000'000);
+}
@@ -0,0 +1,148 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <queue>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <optional>
+#include <iterator>
+#include <condition_variable>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/concurrent/channel.hpp>
+
+namespace {
+constexpr size_t messagesCount = 500'000;
+constexpr size_t channelCapacity = 1024;
+constexpr size_t batchSize = 64;
+
+// bounded queue with mutex and condition variables, the way producer and consumer stages were built before channels
+template <typename T>
+class MutexChannel {
+public:
+    explicit MutexChannel(size_t capacity):
+        capacity_(capacity) {}
+
+    bool send(T value) {
+        std::unique_lock lock(mutex_);
+        spaceNotifier_.wait(lock, [this] { return closed_ || queue_.size() < capacity_; });
+
+        if (closed_) {
+            return false;
+        }
+
+        queue_.push(std::move(value));
+        dataNotifier_.notify_one();
+
+        return true;
+    }
+
+    template <typename OutputIterator>
+    size_t recvMany(OutputIterator output, size_t max) {
+        std::unique_lock lock(mutex_);
+        dataNotifier_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+
+        size_t count = 0;
+
+        for (; count < max && !queue_.empty(); ++count) {
+            *output = std::move(queue_.front());
+            ++output;
+            queue_.pop();
+        }
+
+        spaceNotifier_.notify_all();
+        return count;
+    }
+
+    void close() {
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+
+        dataNotifier_.notify_all();
+        spaceNotifier_.notify_all();
+    }
+
+private:
+    const size_t capacity_;
+    bool closed_ = false;
+    std::queue<T> queue_;
+
+    std::mutex mutex_;
+    std::condition_variable dataNotifier_;
+    std::condition_variable spaceNotifier_;
+};
+
+// sends messages by senders, receives them by receivers batches and reports messages per second
+template <typename Channel>
+void channelBenchmark(const std::string& name, size_t sendersCount, size_t receiversCount) {
+    Channel channel(channelCapacity);
+    std::atomic<size_t> received = { 0 };
+
+    const auto duration = cs::testing::measure([&] {
+        std::vector<std::thread> threads;
+
+        for (size_t i = 0; i < receiversCount; ++i) {
+            threads.emplace_back([&] {
+                std::vector<size_t> values;
+                values.reserve(batchSize);
+
+                while (channel.recvMany(std::back_inserter(values), batchSize) != 0) {
+                    received.fetch_add(values.size(), std::memory_order_relaxed);
+                    values.clear();
+                }
+            });
+        }
+
+        std::vector<std::thread> senders;
+
+        for (size_t i = 0; i < sendersCount; ++i) {
+            senders.emplace_back([&, i] {
+                for (size_t value = i; value < messagesCount; value += sendersCount) {
+                    channel.send(value);
+                }
+            });
+        }
+
+        for (auto& sender : senders) {
+            sender.join();
+        }
+
+        channel.close();
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    ASSERT_EQ(received.load(), messagesCount);
+    cs::testing::report(name, messagesCount, duration);
+}
+}
+
+TEST(ChannelBenchmark, Spsc) {
+    channelBenchmark<cs::SpscChannel<size_t>>("SpscChannel 1 sender 1 receiver", 1, 1);
+}
+
+TEST(ChannelBenchmark, MutexSpsc) {
+    channelBenchmark<MutexChannel<size_t>>("Mutex channel 1 sender 1 receiver", 1, 1);
+}
+
+TEST(ChannelBenchmark, Mpsc) {
+    channelBenchmark<cs::MpscChannel<size_t>>("MpscChannel 4 senders 1 receiver", 4, 1);
+}
+
+TEST(ChannelBenchmark, MutexMpsc) {
+    channelBenchmark<MutexChannel<size_t>>("Mutex channel 4 senders 1 receiver", 4, 1);
+}
+
+TEST(ChannelBenchmark, Mpmc) {
+    channelBenchmark<cs::MpmcChannel<size_t>>("MpmcChannel 4 senders 4 receivers", 4, 4);
+}
+
+TEST(ChannelBenchmark, MutexMpmc) {
+    channelBenchmark<MutexChannel<size_t>>("Mutex channel 4 senders 4 receivers", 4, 4);
+}
@@ -0,0 +1,93 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <cs/concurrent/coroutine.hpp>
+
+#ifdef CS_COROUTINES_SUPPORTED
+
+#include <mutex>
+#include <condition_variable>
+
+#include <benchmark_utils.hpp>
+
+namespace {
+constexpr size_t hopsCount = 100'000;
+
+cs::CoTask<void> scheduleHops(cs::ThreadPool& pool, size_t hops) {
+    for (size_t i = 0; i < hops; ++i) {
+        co_await pool.schedule();
+    }
+}
+
+cs::CoTask<void> watcherHops(size_t hops) {
+    for (size_t i = 0; i < hops; ++i) {
+        co_await cs::Concurrent::run(cs::RunPolicy::ThreadPool, [] {});
+    }
+}
+
+// every next hop is started by finished signal of previous one
+class SignalChain {
+public:
+    explicit SignalChain(size_t hops):
+        hops_(hops) {}
+
+    void run() {
+        hop();
+
+        std::unique_lock lock(mutex_);
+        notifier_.wait(lock, [this] { return done_; });
+    }
+
+private:
+    void hop() {
+        if (hops_-- == 0) {
+            std::lock_guard lock(mutex_);
+            done_ = true;
+            notifier_.notify_one();
+
+            return;
+        }
+
+        auto watcher = cs::Concurrent::run(cs::RunPolicy::ThreadPool, [] {});
+
+        cs::Connector::connect(&watcher->finished, [this] {
+            hop();
+        });
+    }
+
+    size_t hops_;
+    bool done_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable notifier_;
+};
+}
+
+TEST(CoroutineBenchmark, ScheduleHop) {
+    auto& pool = cs::ThreadPool::instance();
+
+    const auto duration = cs::testing::measure([&] {
+        scheduleHops(pool, hopsCount).get();
+    });
+
+    cs::testing::reportLatency("Coroutine pool.schedule hop", hopsCount, duration);
+}
+
+TEST(CoroutineBenchmark, AwaitWatcherHop) {
+    const auto duration = cs::testing::measure([&] {
+        watcherHops(hopsCount).get();
+    });
+
+    cs::testing::reportLatency("Coroutine co_await watcher hop", hopsCount, duration);
+}
+
+TEST(CoroutineBenchmark, SignalChainHop) {
+    const auto duration = cs::testing::measure([&] {
+        SignalChain(hopsCount).run();
+    });
+
+    cs::testing::reportLatency("FutureWatcher signal chain hop", hopsCount, duration);
+}
+
+#endif // CS_COROUTINES_SUPPORTED
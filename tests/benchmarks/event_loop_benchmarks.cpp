@@ -0,0 +1,118 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/concurrent/event_loop.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t samplesCount = 1000;
+constexpr auto samplesGap = std::chrono::microseconds(50);
+constexpr size_t tasksCount = 1'000'000;
+
+// measures time from post to task start, loop is given time to fall asleep before every post
+void postLatency(const std::string& name) {
+    cs::EventLoopThread thread;
+
+    std::vector<double> samples;
+    samples.reserve(samplesCount);
+
+    for (size_t i = 0; i < samplesCount; ++i) {
+        std::this_thread::sleep_for(samplesGap);
+
+        std::atomic<Clock::rep> started = { 0 };
+        const auto posted = Clock::now();
+
+        thread.loop().post([&] {
+            started.store(Clock::now().time_since_epoch().count(), std::memory_order_release);
+        });
+
+        cs::Waiter::wait([&] { return started.load(std::memory_order_acquire) == 0; }, 2000);
+
+        const auto latency = Clock::duration(started.load() - posted.time_since_epoch().count());
+        samples.push_back(std::chrono::duration<double, std::micro>(latency).count());
+    }
+
+    cs::testing::reportPercentiles(name, samples);
+}
+
+// producers post tasks as fast as they could, loop drains them by batches
+void postThroughput(const std::string& name, size_t producersCount) {
+    cs::EventLoopThread thread;
+    std::atomic<size_t> counter = { 0 };
+
+    const auto duration = cs::testing::measure([&] {
+        std::vector<std::thread> producers;
+
+        for (size_t i = 0; i < producersCount; ++i) {
+            producers.emplace_back([&] {
+                for (size_t j = 0; j < tasksCount / producersCount; ++j) {
+                    thread.loop().post([&] {
+                        counter.fetch_add(1, std::memory_order_relaxed);
+                    });
+                }
+            });
+        }
+
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        cs::Waiter::wait([&] { return counter.load(std::memory_order_relaxed) != tasksCount; }, 60000);
+    });
+
+    ASSERT_EQ(counter.load(), tasksCount);
+    cs::testing::report(name, tasksCount, duration);
+}
+
+// posts batch and drains it by one processEvents call at the same thread
+void batchDrain(const std::string& name, size_t batchSize) {
+    cs::EventLoop loop;
+    size_t counter = 0;
+
+    const auto duration = cs::testing::measure([&] {
+        for (size_t i = 0; i < tasksCount / batchSize; ++i) {
+            for (size_t j = 0; j < batchSize; ++j) {
+                loop.post([&] {
+                    ++counter;
+                });
+            }
+
+            loop.processEvents();
+        }
+    });
+
+    ASSERT_EQ(counter, tasksCount / batchSize * batchSize);
+    cs::testing::report(name, counter, duration);
+}
+}
+
+TEST(EventLoopBenchmark, PostLatency) {
+    postLatency("EventLoop post to run latency");
+}
+
+TEST(EventLoopBenchmark, PostThroughputOneProducer) {
+    postThroughput("EventLoop post throughput, 1 producer", 1);
+}
+
+TEST(EventLoopBenchmark, PostThroughputFourProducers) {
+    postThroughput("EventLoop post throughput, 4 producers", 4);
+}
+
+TEST(EventLoopBenchmark, BatchDrain1) {
+    batchDrain("EventLoop post and drain, batch 1", 1);
+}
+
+TEST(EventLoopBenchmark, BatchDrain1000) {
+    batchDrain("EventLoop post and drain, batch 1000", 1000);
+}
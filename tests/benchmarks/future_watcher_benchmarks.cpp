@@ -0,0 +1,116 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/concurrent/when.hpp>
+#include <cs/concurrent/concurrent.hpp>
+
+namespace {
+void watchersBenchmark(const std::string& name, cs::RunPolicy policy, size_t watchersCount) {
+    std::atomic<size_t> counter = { 0 };
+
+    const auto duration = cs::testing::measure([&] {
+        for (size_t i = 0; i < watchersCount; ++i) {
+            auto watcher = cs::Concurrent::run(policy, [](size_t value) {
+                return value;
+            }, i);
+
+            cs::Connector::connect(&watcher->finished, [&](size_t) {
+                counter.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+
+        cs::Waiter::wait([&] { return counter.load(std::memory_order_acquire) != watchersCount; }, 60000);
+    });
+
+    ASSERT_EQ(counter.load(), watchersCount);
+    cs::testing::report(name, watchersCount, duration);
+}
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t requestsCount = 100;
+constexpr size_t childrenCount = 8;
+
+// child of scatter request sleeps by its index and returns its finish time
+cs::FutureWatcherPtr<Clock::rep> scatterChild(size_t index) {
+    return cs::Concurrent::run(cs::RunPolicy::ThreadPool, [index] {
+        std::this_thread::sleep_for(std::chrono::microseconds(100 * (index + 1)));
+        return Clock::now().time_since_epoch().count();
+    });
+}
+
+// measures time from finish of the slowest child to gathered result, gather waits children by whenAll
+// or by polling counter which children results increment
+void scatterGather(const std::string& name, bool combined) {
+    std::vector<double> samples;
+    samples.reserve(requestsCount);
+
+    for (size_t i = 0; i < requestsCount; ++i) {
+        std::vector<cs::FutureWatcherPtr<Clock::rep>> children;
+
+        for (size_t j = 0; j < childrenCount; ++j) {
+            children.push_back(scatterChild(j));
+        }
+
+        std::atomic<Clock::rep> slowest = { 0 };
+        std::atomic<Clock::rep> gathered = { 0 };
+
+        if (combined) {
+            cs::Connector::connect(&cs::whenAll(children)->finished, [&](const std::vector<Clock::rep>& results) {
+                slowest.store(*std::max_element(results.begin(), results.end()), std::memory_order_relaxed);
+                gathered.store(Clock::now().time_since_epoch().count(), std::memory_order_release);
+            });
+
+            cs::Waiter::wait([&] { return gathered.load(std::memory_order_acquire) == 0; }, 2000);
+        }
+        else {
+            std::atomic<size_t> counter = { 0 };
+
+            for (auto& child : children) {
+                cs::Connector::connect(&child->finished, [&](Clock::rep finish) {
+                    Clock::rep current = slowest.load(std::memory_order_relaxed);
+
+                    while (current < finish && !slowest.compare_exchange_weak(current, finish, std::memory_order_relaxed)) {}
+                    counter.fetch_add(1, std::memory_order_release);
+                });
+            }
+
+            cs::Waiter::wait([&] { return counter.load(std::memory_order_acquire) != childrenCount; }, 2000);
+            gathered.store(Clock::now().time_since_epoch().count(), std::memory_order_release);
+        }
+
+        ASSERT_NE(gathered.load(), 0);
+
+        const auto latency = Clock::duration(gathered.load() - slowest.load());
+        samples.push_back(std::chrono::duration<double, std::micro>(latency).count());
+    }
+
+    cs::testing::reportPercentiles(name, samples);
+}
+}
+
+TEST(FutureWatcherBenchmark, ThreadPoolPolicy100k) {
+    watchersBenchmark("FutureWatcher thread pool policy", cs::RunPolicy::ThreadPool, 100'000);
+}
+
+TEST(FutureWatcherBenchmark, ThreadPolicy10k) {
+    watchersBenchmark("FutureWatcher thread policy", cs::RunPolicy::Thread, 10'000);
+}
+
+TEST(FutureWatcherBenchmark, ScatterGatherPolling) {
+    scatterGather("Scatter gather, polling counter after slowest child", false);
+}
+
+TEST(FutureWatcherBenchmark, ScatterGatherWhenAll) {
+    scatterGather("Scatter gather, whenAll after slowest child", true);
+}
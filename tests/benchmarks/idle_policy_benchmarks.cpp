@@ -0,0 +1,75 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/utils/pause.hpp>
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t samplesCount = 5000;
+
+// pause between samples, workers become idle but spinning workers do not park yet
+constexpr auto samplesGap = std::chrono::microseconds(20);
+
+// measures time from enqueue call to task start
+void startLatency(const std::string& name, const cs::ThreadPoolOptions& options) {
+    cs::ThreadPool pool(options);
+    std::vector<double> samples;
+    samples.reserve(samplesCount);
+
+    for (size_t i = 0; i < samplesCount; ++i) {
+        std::atomic<bool> started = { false };
+        std::atomic<Clock::rep> latency = { 0 };
+
+        const auto start = Clock::now();
+
+        pool.enqueue([&] {
+            latency.store((Clock::now() - start).count(), std::memory_order_relaxed);
+            started.store(true, std::memory_order_release);
+        });
+
+        while (!started.load(std::memory_order_acquire)) {
+            cs::details::cpuPause();
+        }
+
+        samples.push_back(std::chrono::duration<double, std::micro>(Clock::duration(latency.load())).count());
+
+        const auto gapEnd = Clock::now() + samplesGap;
+
+        while (Clock::now() < gapEnd) {
+            cs::details::cpuPause();
+        }
+    }
+
+    cs::testing::reportPercentiles(name, samples);
+}
+
+cs::ThreadPoolOptions options(cs::IdlePolicy idle, size_t hotWorkers = 0) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 4;
+    options.idle = idle;
+    options.hotWorkers = hotWorkers;
+
+    return options;
+}
+}
+
+TEST(IdlePolicyBenchmark, Park) {
+    startLatency("Enqueue to start, park", options(cs::IdlePolicy::Park));
+}
+
+TEST(IdlePolicyBenchmark, SpinThenPark) {
+    startLatency("Enqueue to start, spin then park", options(cs::IdlePolicy::SpinThenPark));
+}
+
+TEST(IdlePolicyBenchmark, OneHotWorker) {
+    startLatency("Enqueue to start, park with one hot worker", options(cs::IdlePolicy::Park, 1));
+}
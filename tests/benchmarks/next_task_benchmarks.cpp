@@ -0,0 +1,135 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/concurrent/event.hpp>
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace {
+constexpr size_t valuesCount = 1 << 20;
+constexpr size_t leafSize = 1024;
+constexpr size_t repeatsCount = 10;
+
+// recursive sum of squares, every task splits its range in two follow ups until range fits leaf,
+// leaf writes squares and enqueues follow up which sums them, so data of both tree levels exceeds cache,
+// follow up of slot runs at the same worker while squares are at cache
+struct SumTree {
+    SumTree(cs::ThreadPool& pool, const std::vector<uint64_t>& values):
+        pool_(pool), values_(values), squares_(values.size()) {}
+
+    uint64_t run() {
+        total_.store(0, std::memory_order_relaxed);
+        leaves_.store(valuesCount / leafSize, std::memory_order_relaxed);
+        done_.reset();
+
+        pool_.enqueue([this] {
+            split(0, valuesCount);
+        });
+
+        done_.wait();
+        return total_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void split(size_t first, size_t last) {
+        if (last - first <= leafSize) {
+            for (size_t i = first; i < last; ++i) {
+                squares_[i] = values_[i] * values_[i];
+            }
+
+            pool_.enqueue([this, first, last] {
+                sum(first, last);
+            });
+
+            return;
+        }
+
+        const size_t middle = first + (last - first) / 2;
+
+        pool_.enqueue([this, middle, last] {
+            split(middle, last);
+        });
+
+        pool_.enqueue([this, first, middle] {
+            split(first, middle);
+        });
+    }
+
+    void sum(size_t first, size_t last) {
+        total_.fetch_add(std::accumulate(squares_.begin() + static_cast<std::ptrdiff_t>(first),
+                                         squares_.begin() + static_cast<std::ptrdiff_t>(last), uint64_t(0)), std::memory_order_relaxed);
+
+        if (leaves_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done_.set();
+        }
+    }
+
+    cs::ThreadPool& pool_;
+    const std::vector<uint64_t>& values_;
+    std::vector<uint64_t> squares_;
+
+    std::atomic<uint64_t> total_ = { 0 };
+    std::atomic<size_t> leaves_ = { 0 };
+    cs::Event done_;
+};
+
+void divideAndConquer(const std::string& name, cs::SchedulePolicy policy, bool nextTaskSlot) {
+    std::vector<uint64_t> values(valuesCount);
+    std::iota(values.begin(), values.end(), uint64_t(0));
+
+    const auto expected = std::inner_product(values.begin(), values.end(), values.begin(), uint64_t(0));
+
+    cs::ThreadPoolOptions options;
+    options.threadsCount = std::max(1u, std::thread::hardware_concurrency());
+    options.schedule = policy;
+    options.nextTaskSlot = nextTaskSlot;
+
+    cs::ThreadPool pool(options);
+    SumTree tree(pool, values);
+
+    // warm up
+    ASSERT_EQ(tree.run(), expected);
+
+    const auto duration = cs::testing::measure([&] {
+        for (size_t i = 0; i < repeatsCount; ++i) {
+            ASSERT_EQ(tree.run(), expected);
+        }
+    });
+
+    // every tree has three tasks per leaf
+    cs::testing::report(name, repeatsCount * (valuesCount / leafSize) * 3, duration);
+}
+}
+
+TEST(NextTaskBenchmark, SharedQueueFifo) {
+    divideAndConquer("Divide and conquer, shared queue without next slot", cs::SchedulePolicy::SharedQueue, false);
+}
+
+TEST(NextTaskBenchmark, SharedQueueNextSlot) {
+    divideAndConquer("Divide and conquer, shared queue with next slot", cs::SchedulePolicy::SharedQueue, true);
+}
+
+TEST(NextTaskBenchmark, WorkStealingFifo) {
+    divideAndConquer("Divide and conquer, work stealing without next slot", cs::SchedulePolicy::WorkStealing, false);
+}
+
+TEST(NextTaskBenchmark, WorkStealingNextSlot) {
+    divideAndConquer("Divide and conquer, work stealing with next slot", cs::SchedulePolicy::WorkStealing, true);
+}
+
+TEST(NextTaskBenchmark, LockFreeFifo) {
+    divideAndConquer("Divide and conquer, lock free ring without next slot", cs::SchedulePolicy::LockFree, false);
+}
+
+TEST(NextTaskBenchmark, LockFreeNextSlot) {
+    divideAndConquer("Divide and conquer, lock free ring with next slot", cs::SchedulePolicy::LockFree, true);
+}
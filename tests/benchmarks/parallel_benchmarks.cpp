@@ -0,0 +1,149 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/concurrent/parallel.hpp>
+
+namespace {
+constexpr size_t valuesCount = 2'000'000;
+
+std::vector<double> makeValues() {
+    std::vector<double> values(valuesCount);
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(0.0, 1000.0);
+
+    std::generate(values.begin(), values.end(), [&] { return distribution(generator); });
+    return values;
+}
+
+// thread counts from 1 to hardware concurrency doubling every step
+std::vector<size_t> threadCounts() {
+    std::vector<size_t> counts;
+    const size_t maxCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t count = 1; count < maxCount; count *= 2) {
+        counts.push_back(count);
+    }
+
+    counts.push_back(maxCount);
+    return counts;
+}
+
+std::string threadsName(const std::string& name, size_t threads) {
+    return name + ", " + std::to_string(threads) + " threads";
+}
+}
+
+TEST(ParallelBenchmark, For) {
+    auto values = makeValues();
+    auto expected = values;
+
+    cs::testing::report("std::for_each", valuesCount, cs::testing::measure([&] {
+        std::for_each(expected.begin(), expected.end(), [](double& value) { value = std::sqrt(value); });
+    }));
+
+    for (auto threads : threadCounts()) {
+        auto result = values;
+        cs::ThreadPool pool(threads);
+
+        cs::testing::report(threadsName("cs::parallelFor", threads), valuesCount, cs::testing::measure([&] {
+            cs::parallelFor(pool, size_t(0), result.size(), 0, [&](size_t index) { result[index] = std::sqrt(result[index]); });
+        }));
+
+        ASSERT_EQ(result, expected);
+    }
+}
+
+TEST(ParallelBenchmark, Transform) {
+    const auto values = makeValues();
+    std::vector<double> expected(values.size());
+
+    auto op = [](double value) { return std::sin(value) * std::cos(value); };
+
+    cs::testing::report("std::transform", valuesCount, cs::testing::measure([&] {
+        std::transform(values.begin(), values.end(), expected.begin(), op);
+    }));
+
+    for (auto threads : threadCounts()) {
+        std::vector<double> result(values.size());
+        cs::ThreadPool pool(threads);
+
+        cs::testing::report(threadsName("cs::parallelTransform", threads), valuesCount, cs::testing::measure([&] {
+            cs::parallelTransform(pool, values.begin(), values.end(), result.begin(), op);
+        }));
+
+        ASSERT_EQ(result, expected);
+    }
+}
+
+TEST(ParallelBenchmark, Reduce) {
+    std::vector<long long> values(valuesCount);
+    std::iota(values.begin(), values.end(), 0);
+
+    long long expected = 0;
+
+    cs::testing::report("std::accumulate", valuesCount, cs::testing::measure([&] {
+        expected = std::accumulate(values.begin(), values.end(), 0LL);
+    }));
+
+    for (auto threads : threadCounts()) {
+        long long result = 0;
+        cs::ThreadPool pool(threads);
+
+        cs::testing::report(threadsName("cs::parallelReduce", threads), valuesCount, cs::testing::measure([&] {
+            result = cs::parallelReduce(pool, values.begin(), values.end(), 0LL);
+        }));
+
+        ASSERT_EQ(result, expected);
+    }
+}
+
+TEST(ParallelBenchmark, Scan) {
+    std::vector<long long> values(valuesCount);
+    std::vector<long long> expected(valuesCount);
+
+    std::iota(values.begin(), values.end(), 0);
+
+    cs::testing::report("std::partial_sum", valuesCount, cs::testing::measure([&] {
+        std::partial_sum(values.begin(), values.end(), expected.begin());
+    }));
+
+    for (auto threads : threadCounts()) {
+        std::vector<long long> result(valuesCount);
+        cs::ThreadPool pool(threads);
+
+        cs::testing::report(threadsName("cs::parallelScan", threads), valuesCount, cs::testing::measure([&] {
+            cs::parallelScan(pool, values.begin(), values.end(), result.begin());
+        }));
+
+        ASSERT_EQ(result, expected);
+    }
+}
+
+TEST(ParallelBenchmark, Sort) {
+    const auto values = makeValues();
+    auto expected = values;
+
+    cs::testing::report("std::sort", valuesCount, cs::testing::measure([&] {
+        std::sort(expected.begin(), expected.end());
+    }));
+
+    for (auto threads : threadCounts()) {
+        auto result = values;
+        cs::ThreadPool pool(threads);
+
+        cs::testing::report(threadsName("cs::parallelSort", threads), valuesCount, cs::testing::measure([&] {
+            cs::parallelSort(pool, result.begin(), result.end());
+        }));
+
+        ASSERT_EQ(result, expected);
+    }
+}
@@ -0,0 +1,123 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <functional>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/utils/pause.hpp>
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t samplesCount = 200;
+
+// queued background tasks, every task takes about taskDuration
+constexpr int64_t backgroundDepth = 256;
+constexpr auto taskDuration = std::chrono::microseconds(10);
+constexpr auto samplesGap = std::chrono::microseconds(100);
+
+using Enqueue = std::function<void(cs::ThreadPool&, std::function<void()>)>;
+
+void busyWait(Clock::duration duration) {
+    const auto end = Clock::now() + duration;
+
+    while (Clock::now() < end) {
+        cs::details::cpuPause();
+    }
+}
+
+// measures enqueue to start time of probe tasks while pool is saturated by background tasks,
+// every finished background task adds its replacement, so queue depth stays the same
+void tailLatency(const std::string& name, const Enqueue& background, const Enqueue& probe) {
+    cs::ThreadPool pool(4);
+
+    std::atomic<bool> stop = { false };
+    std::atomic<int64_t> outstanding = { 0 };
+
+    std::function<void()> load = [&] {
+        busyWait(taskDuration);
+
+        if (!stop.load(std::memory_order_acquire)) {
+            background(pool, load);
+        }
+        else {
+            outstanding.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    };
+
+    outstanding.store(backgroundDepth, std::memory_order_release);
+
+    for (int64_t i = 0; i < backgroundDepth; ++i) {
+        background(pool, load);
+    }
+
+    std::vector<double> samples;
+    samples.reserve(samplesCount);
+
+    for (size_t i = 0; i < samplesCount; ++i) {
+        std::atomic<bool> started = { false };
+        std::atomic<Clock::rep> latency = { 0 };
+
+        const auto start = Clock::now();
+
+        probe(pool, [&] {
+            latency.store((Clock::now() - start).count(), std::memory_order_relaxed);
+            started.store(true, std::memory_order_release);
+        });
+
+        while (!started.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        samples.push_back(std::chrono::duration<double, std::micro>(Clock::duration(latency.load())).count());
+        std::this_thread::sleep_for(samplesGap);
+    }
+
+    stop.store(true, std::memory_order_release);
+
+    while (outstanding.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+
+    cs::testing::reportPercentiles(name, samples);
+}
+
+void enqueueNormal(cs::ThreadPool& pool, std::function<void()> func) {
+    pool.enqueue(std::move(func));
+}
+
+void enqueueLow(cs::ThreadPool& pool, std::function<void()> func) {
+    pool.enqueue(cs::TaskPriority::Low, std::move(func));
+}
+
+void enqueueHigh(cs::ThreadPool& pool, std::function<void()> func) {
+    pool.enqueue(cs::TaskPriority::High, std::move(func));
+}
+
+void enqueueDeadline(cs::ThreadPool& pool, std::function<void()> func) {
+    pool.enqueue(Clock::now() + std::chrono::microseconds(100), std::move(func));
+}
+}
+
+TEST(PriorityBenchmark, SingleFifo) {
+    tailLatency("Probe start latency, one fifo queue", enqueueNormal, enqueueNormal);
+}
+
+TEST(PriorityBenchmark, HighOverLow) {
+    tailLatency("Probe start latency, high lane over low load", enqueueLow, enqueueHigh);
+}
+
+TEST(PriorityBenchmark, HighOverNormal) {
+    tailLatency("Probe start latency, high lane over normal load", enqueueNormal, enqueueHigh);
+}
+
+TEST(PriorityBenchmark, DeadlineOverLow) {
+    tailLatency("Probe start latency, deadline over low load", enqueueLow, enqueueDeadline);
+}
@@ -0,0 +1,159 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <ctime>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <functional>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/concurrent/event.hpp>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t samplesCount = 200;
+constexpr auto samplesGap = std::chrono::microseconds(200);
+constexpr auto idleDuration = std::chrono::milliseconds(100);
+constexpr int waitLimit = 10000;
+
+// signal side makes condition true and wakes waiting side
+struct WaitStrategy {
+    std::function<void()> reset;
+    std::function<void()> wait;
+    std::function<void()> signal;
+};
+
+struct PollingStrategy : WaitStrategy {
+    PollingStrategy() {
+        reset = [this] { flag.store(false, std::memory_order_release); };
+        wait = [this] { cs::Waiter::wait([this] { return !flag.load(std::memory_order_acquire); }, waitLimit); };
+        signal = [this] { flag.store(true, std::memory_order_release); };
+    }
+
+    std::atomic<bool> flag = { false };
+};
+
+struct NotifierStrategy : WaitStrategy {
+    NotifierStrategy() {
+        reset = [this] { flag.store(false, std::memory_order_release); };
+        wait = [this] { cs::Waiter::wait(notifier, [this] { return !flag.load(std::memory_order_acquire); }, waitLimit); };
+        signal = [this] {
+            flag.store(true, std::memory_order_release);
+            notifier.notify();
+        };
+    }
+
+    std::atomic<bool> flag = { false };
+    cs::Notifier notifier;
+};
+
+struct EventStrategy : WaitStrategy {
+    EventStrategy() {
+        reset = [this] { event.reset(); };
+        wait = [this] { event.wait(); };
+        signal = [this] { event.set(); };
+    }
+
+    cs::Event event;
+};
+
+// returns processor time consumed by calling thread
+std::chrono::nanoseconds threadCpuTime() {
+#if defined(__linux__)
+    timespec spec{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &spec);
+
+    return std::chrono::seconds(spec.tv_sec) + std::chrono::nanoseconds(spec.tv_nsec);
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(static_cast<double>(std::clock()) / CLOCKS_PER_SEC));
+#endif
+}
+
+// measures time from signal to return of wait, waiting thread is given time to fall asleep before every signal
+void wakeLatency(const std::string& name, WaitStrategy& strategy) {
+    std::vector<double> samples;
+    samples.reserve(samplesCount);
+
+    for (size_t i = 0; i < samplesCount; ++i) {
+        strategy.reset();
+
+        std::atomic<Clock::rep> signalled = { 0 };
+        std::atomic<Clock::rep> woken = { 0 };
+
+        std::thread waiting([&] {
+            strategy.wait();
+            woken.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        });
+
+        std::this_thread::sleep_for(samplesGap);
+
+        signalled.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        strategy.signal();
+
+        waiting.join();
+
+        const auto latency = Clock::duration(woken.load() - signalled.load());
+        samples.push_back(std::chrono::duration<double, std::micro>(latency).count());
+    }
+
+    cs::testing::reportPercentiles(name, samples);
+}
+
+// measures processor time burnt by thread which waits idleDuration for signal
+void idleCpuUsage(const std::string& name, WaitStrategy& strategy) {
+    strategy.reset();
+
+    std::atomic<std::chrono::nanoseconds::rep> consumed = { 0 };
+
+    std::thread waiting([&] {
+        const auto start = threadCpuTime();
+        strategy.wait();
+        consumed.store((threadCpuTime() - start).count(), std::memory_order_relaxed);
+    });
+
+    std::this_thread::sleep_for(idleDuration);
+    strategy.signal();
+
+    waiting.join();
+
+    const auto cpu = std::chrono::duration<double, std::milli>(std::chrono::nanoseconds(consumed.load()));
+    cslog() << name << ": waited " << idleDuration.count() << " ms, cpu time " << cpu.count() << " ms";
+}
+}
+
+TEST(SyncBenchmark, PollingWaiterWakeLatency) {
+    PollingStrategy strategy;
+    wakeLatency("Wake latency, polling Waiter", strategy);
+}
+
+TEST(SyncBenchmark, NotifierWaiterWakeLatency) {
+    NotifierStrategy strategy;
+    wakeLatency("Wake latency, Waiter with Notifier", strategy);
+}
+
+TEST(SyncBenchmark, EventWakeLatency) {
+    EventStrategy strategy;
+    wakeLatency("Wake latency, futex Event", strategy);
+}
+
+TEST(SyncBenchmark, PollingWaiterCpuUsage) {
+    PollingStrategy strategy;
+    idleCpuUsage("Idle cpu usage, polling Waiter", strategy);
+}
+
+TEST(SyncBenchmark, NotifierWaiterCpuUsage) {
+    NotifierStrategy strategy;
+    idleCpuUsage("Idle cpu usage, Waiter with Notifier", strategy);
+}
+
+TEST(SyncBenchmark, EventCpuUsage) {
+    EventStrategy strategy;
+    idleCpuUsage("Idle cpu usage, futex Event", strategy);
+}
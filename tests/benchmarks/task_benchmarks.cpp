@@ -0,0 +1,103 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace {
+constexpr size_t tasksCount = 100'000;
+
+// emulates previous ThreadPool task creation
+template <typename F>
+std::function<void()> makeLegacyTask(F&& f) {
+    using ResultType = std::invoke_result_t<F>;
+
+    const auto task = std::make_shared<std::packaged_task<ResultType()>>(std::bind(std::forward<F>(f)));
+
+    return [task] {
+        (*task)();
+    };
+}
+
+template <typename Func>
+void reportAllocations(const std::string& name, Func&& func) {
+    const auto before = cs::testing::allocationsCount();
+    const auto duration = cs::testing::measure(std::forward<Func>(func));
+    const auto allocations = cs::testing::allocationsCount() - before;
+
+    cs::testing::report(name, tasksCount, duration);
+    cslog() << name << ": " << static_cast<double>(allocations) / tasksCount << " allocations per task";
+}
+}
+
+TEST(TaskBenchmark, CreateAndCallLegacyFunction) {
+    std::atomic<size_t> value = { 0 };
+
+    reportAllocations("std::function with shared packaged task", [&] {
+        for (size_t i = 0; i < tasksCount; ++i) {
+            auto task = makeLegacyTask([&value, i] {
+                value.fetch_add(i, std::memory_order_relaxed);
+            });
+
+            task();
+        }
+    });
+
+    ASSERT_NE(value.load(), 0u);
+}
+
+TEST(TaskBenchmark, CreateAndCallTask) {
+    std::atomic<size_t> value = { 0 };
+
+    reportAllocations("cs::Task", [&] {
+        for (size_t i = 0; i < tasksCount; ++i) {
+            cs::Task task([&value, i] {
+                value.fetch_add(i, std::memory_order_relaxed);
+            });
+
+            task();
+        }
+    });
+
+    ASSERT_NE(value.load(), 0u);
+}
+
+TEST(TaskBenchmark, CreateAndCallPackagedTask) {
+    std::atomic<size_t> value = { 0 };
+
+    reportAllocations("cs::Task with packaged task", [&] {
+        for (size_t i = 0; i < tasksCount; ++i) {
+            std::packaged_task<void()> packagedTask([&value, i] {
+                value.fetch_add(i, std::memory_order_relaxed);
+            });
+
+            cs::Task task(std::move(packagedTask));
+            task();
+        }
+    });
+
+    ASSERT_NE(value.load(), 0u);
+}
+
+TEST(TaskBenchmark, ThreadPoolEnqueueFuture) {
+    cs::ThreadPool pool(2);
+    std::vector<std::future<size_t>> futures;
+    futures.reserve(tasksCount);
+
+    reportAllocations("ThreadPool::enqueueFuture", [&] {
+        for (size_t i = 0; i < tasksCount; ++i) {
+            futures.push_back(pool.enqueueFuture([i] {
+                return i;
+            }));
+        }
+
+        for (auto& future : futures) {
+            future.get();
+        }
+    });
+}
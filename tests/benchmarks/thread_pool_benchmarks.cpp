@@ -0,0 +1,104 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <benchmark_utils.hpp>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/concurrent/thread_pool.hpp>
+
+namespace {
+constexpr size_t tasksCount = 200'000;
+constexpr size_t spawnersCount = 1'000;
+constexpr size_t childrenCount = 200;
+
+const char* policyName(cs::SchedulePolicy policy) {
+    switch (policy) {
+    case cs::SchedulePolicy::SharedQueue:
+        return "SharedQueue";
+
+    case cs::SchedulePolicy::WorkStealing:
+        return "WorkStealing";
+
+    case cs::SchedulePolicy::LockFree:
+        return "LockFree";
+    }
+
+    return "";
+}
+
+size_t threadsCount() {
+    return std::max(2u, std::thread::hardware_concurrency());
+}
+
+// external producer floods pool with tiny tasks
+void externalThroughput(cs::SchedulePolicy policy) {
+    std::atomic<size_t> counter = { 0 };
+    cs::ThreadPool pool(threadsCount(), policy);
+
+    const auto duration = cs::testing::measure([&] {
+        for (size_t i = 0; i < tasksCount; ++i) {
+            pool.enqueue([&] {
+                counter.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+
+        cs::Waiter::wait([&] { return counter.load(std::memory_order_acquire) != tasksCount; }, 30000);
+    });
+
+    ASSERT_EQ(counter.load(), tasksCount);
+    cs::testing::report(std::string("ThreadPool external enqueue, ") + policyName(policy), tasksCount, duration);
+}
+
+// tasks fan out children from workers
+void nestedThroughput(cs::SchedulePolicy policy) {
+    constexpr size_t total = spawnersCount * childrenCount;
+
+    std::atomic<size_t> counter = { 0 };
+    cs::ThreadPool pool(threadsCount(), policy);
+
+    const auto duration = cs::testing::measure([&] {
+        for (size_t i = 0; i < spawnersCount; ++i) {
+            pool.enqueue([&] {
+                for (size_t j = 0; j < childrenCount; ++j) {
+                    pool.enqueue([&] {
+                        counter.fetch_add(1, std::memory_order_relaxed);
+                    });
+                }
+            });
+        }
+
+        cs::Waiter::wait([&] { return counter.load(std::memory_order_acquire) != total; }, 30000);
+    });
+
+    ASSERT_EQ(counter.load(), total);
+    cs::testing::report(std::string("ThreadPool nested enqueue, ") + policyName(policy), total, duration);
+}
+}
+
+TEST(ThreadPoolBenchmark, ExternalEnqueueSharedQueue) {
+    externalThroughput(cs::SchedulePolicy::SharedQueue);
+}
+
+TEST(ThreadPoolBenchmark, ExternalEnqueueWorkStealing) {
+    externalThroughput(cs::SchedulePolicy::WorkStealing);
+}
+
+TEST(ThreadPoolBenchmark, NestedEnqueueSharedQueue) {
+    nestedThroughput(cs::SchedulePolicy::SharedQueue);
+}
+
+TEST(ThreadPoolBenchmark, NestedEnqueueWorkStealing) {
+    nestedThroughput(cs::SchedulePolicy::WorkStealing);
+}
+
+TEST(ThreadPoolBenchmark, ExternalEnqueueLockFree) {
+    externalThroughput(cs::SchedulePolicy::LockFree);
+}
+
+TEST(ThreadPoolBenchmark, NestedEnqueueLockFree) {
+    nestedThroughput(cs::SchedulePolicy::LockFree);
+}
@@ -0,0 +1,181 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/concurrent/concurrent.hpp>
+#include <cs/concurrent/cancellation.hpp>
+
+TEST(Cancellation, BaseUsage) {
+    cs::CancellationToken defaultToken;
+
+    ASSERT_FALSE(defaultToken.canBeCancelled());
+    ASSERT_FALSE(defaultToken.isCancelled());
+    ASSERT_NO_THROW(defaultToken.throwIfCancelled());
+
+    cs::CancellationSource source;
+    auto token = source.token();
+    size_t calls = 0;
+
+    token.onCancelled([&] {
+        ++calls;
+    });
+
+    ASSERT_TRUE(token.canBeCancelled());
+    ASSERT_FALSE(token.isCancelled());
+    ASSERT_EQ(calls, 0u);
+
+    ASSERT_TRUE(source.cancel());
+    ASSERT_FALSE(source.cancel());
+
+    ASSERT_TRUE(source.isCancelled());
+    ASSERT_TRUE(token.isCancelled());
+    ASSERT_THROW(token.throwIfCancelled(), cs::CancelledException);
+    ASSERT_EQ(calls, 1u);
+
+    // late callback is called at once
+    token.onCancelled([&] {
+        ++calls;
+    });
+
+    ASSERT_EQ(calls, 2u);
+}
+
+TEST(Cancellation, RemoveCallback) {
+    cs::CancellationSource source;
+    auto token = source.token();
+
+    size_t removedCalls = 0;
+    size_t calls = 0;
+
+    const auto removed = token.onCancelled([&] {
+        ++removedCalls;
+    });
+
+    const auto kept = token.onCancelled([&] {
+        ++calls;
+    });
+
+    ASSERT_NE(removed, kept);
+    ASSERT_TRUE(token.removeCallback(removed));
+    ASSERT_FALSE(token.removeCallback(removed));
+
+    ASSERT_TRUE(source.cancel());
+    ASSERT_EQ(removedCalls, 0u);
+    ASSERT_EQ(calls, 1u);
+
+    // called callback could not be removed
+    ASSERT_FALSE(token.removeCallback(kept));
+
+    // callback of cancelled token is called at once and is not kept
+    ASSERT_EQ(token.onCancelled([&] { ++calls; }), 0u);
+    ASSERT_EQ(calls, 2u);
+
+    cs::CancellationToken defaultToken;
+    ASSERT_EQ(defaultToken.onCancelled([&] { ++calls; }), 0u);
+    ASSERT_FALSE(defaultToken.removeCallback(0));
+}
+
+TEST(Cancellation, ThreadPoolDropsQueuedTasks) {
+    constexpr size_t tasksCount = 100;
+
+    cs::ThreadPool pool(1);
+    cs::CancellationSource source;
+
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+
+    pool.enqueue([&started, releaseFuture] {
+        started.set_value();
+        releaseFuture.wait();
+    });
+
+    started.get_future().wait();
+
+    std::atomic<size_t> cancelledCalls = { 0 };
+    std::atomic<size_t> calls = { 0 };
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        pool.enqueue(source.token(), [&] {
+            cancelledCalls.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        pool.enqueue([&] {
+            calls.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    source.cancel();
+    release.set_value();
+
+    cs::Waiter::wait([&] { return calls.load() != tasksCount; }, 5000);
+
+    ASSERT_EQ(calls.load(), tasksCount);
+    ASSERT_EQ(cancelledCalls.load(), 0u);
+}
+
+TEST(Cancellation, WatcherCancelledBeforeStart) {
+    cs::CancellationSource source;
+    source.cancel();
+
+    std::atomic<bool> called = { false };
+    std::atomic<bool> finished = { false };
+    std::atomic<bool> cancelled = { false };
+
+    auto watcher = cs::Concurrent::run(source.token(), cs::RunPolicy::ThreadPool, [&] {
+        called = true;
+        return 1;
+    });
+
+    cs::Connector::connect(&watcher->finished, [&](int) {
+        finished = true;
+    });
+
+    cs::Connector::connect(&watcher->cancelled, [&] {
+        cancelled = true;
+    });
+
+    cs::Waiter::wait([&] { return !cancelled.load(); }, 2000);
+
+    ASSERT_TRUE(cancelled);
+    ASSERT_FALSE(called);
+    ASSERT_FALSE(finished);
+}
+
+TEST(Cancellation, WatcherCancelledWhileRunning) {
+    cs::CancellationSource source;
+    auto token = source.token();
+
+    std::atomic<bool> started = { false };
+    std::atomic<bool> failed = { false };
+    std::atomic<bool> cancelled = { false };
+
+    auto watcher = cs::Concurrent::run(token, cs::RunPolicy::Thread, [&started, token] {
+        started = true;
+
+        for (;;) {
+            token.throwIfCancelled();
+            std::this_thread::yield();
+        }
+    });
+
+    cs::Connector::connect(&watcher->failed, [&] {
+        failed = true;
+    });
+
+    cs::Connector::connect(&watcher->cancelled, [&] {
+        cancelled = true;
+    });
+
+    cs::Waiter::wait([&] { return !started.load(); }, 2000);
+    source.cancel();
+
+    cs::Waiter::wait([&] { return !cancelled.load(); }, 2000);
+
+    ASSERT_TRUE(cancelled);
+    ASSERT_FALSE(failed);
+}
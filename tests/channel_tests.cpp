@@ -0,0 +1,250 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <iterator>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/concurrent/channel.hpp>
+
+template <typename Channel>
+static void sendAndReceive(size_t sendersCount, size_t receiversCount) {
+    constexpr size_t valuesCount = 20000;
+
+    Channel channel(64);
+    std::atomic<size_t> sum = { 0 };
+    std::atomic<size_t> received = { 0 };
+
+    std::vector<std::thread> receivers;
+
+    for (size_t i = 0; i < receiversCount; ++i) {
+        receivers.emplace_back([&] {
+            std::vector<size_t> values;
+
+            // receives by batches until channel is closed and empty
+            while (channel.recvMany(std::back_inserter(values), 16) != 0) {
+                for (auto value : values) {
+                    sum.fetch_add(value, std::memory_order_relaxed);
+                }
+
+                received.fetch_add(values.size(), std::memory_order_relaxed);
+                values.clear();
+            }
+        });
+    }
+
+    std::vector<std::thread> senders;
+
+    for (size_t i = 0; i < sendersCount; ++i) {
+        senders.emplace_back([&, i] {
+            for (size_t value = i; value < valuesCount; value += sendersCount) {
+                ASSERT_TRUE(channel.send(value));
+            }
+        });
+    }
+
+    for (auto& sender : senders) {
+        sender.join();
+    }
+
+    channel.close();
+
+    for (auto& receiver : receivers) {
+        receiver.join();
+    }
+
+    ASSERT_EQ(received.load(), valuesCount);
+    ASSERT_EQ(sum.load(), valuesCount * (valuesCount - 1) / 2);
+}
+
+TEST(Channel, Spsc) {
+    sendAndReceive<cs::SpscChannel<size_t>>(1, 1);
+}
+
+TEST(Channel, Mpsc) {
+    sendAndReceive<cs::MpscChannel<size_t>>(4, 1);
+}
+
+TEST(Channel, Mpmc) {
+    sendAndReceive<cs::MpmcChannel<size_t>>(4, 4);
+}
+
+TEST(Channel, TrySendAndClose) {
+    cs::MpmcChannel<std::unique_ptr<int>> channel(2);
+
+    ASSERT_TRUE(channel.trySend(std::make_unique<int>(1)));
+    ASSERT_TRUE(channel.trySend(std::make_unique<int>(2)));
+
+    auto value = std::make_unique<int>(3);
+
+    ASSERT_FALSE(channel.trySend(std::move(value)));
+    ASSERT_NE(value, nullptr);
+
+    channel.close();
+
+    ASSERT_TRUE(channel.isClosed());
+    ASSERT_FALSE(channel.send(std::move(value)));
+
+    // queued values are received after close
+    ASSERT_EQ(**channel.recv(), 1);
+    ASSERT_EQ(**channel.tryRecv(), 2);
+    ASSERT_FALSE(channel.recv().has_value());
+}
+
+// move only message without default constructor
+struct Message {
+    explicit Message(int value):
+        value(std::make_unique<int>(value)) {}
+
+    Message(Message&&) = default;
+    Message& operator=(Message&&) = delete;
+
+    std::unique_ptr<int> value;
+};
+
+template <typename Channel>
+static void receiveMessages() {
+    Channel channel(4);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(channel.trySend(Message(i)));
+    }
+
+    auto first = channel.tryRecv();
+
+    ASSERT_TRUE(first.has_value());
+    ASSERT_EQ(*first->value, 0);
+
+    std::vector<Message> messages;
+    ASSERT_EQ(channel.recvMany(std::back_inserter(messages), 8), 3u);
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(*messages[static_cast<size_t>(i)].value, i + 1);
+    }
+}
+
+TEST(Channel, NotDefaultConstructibleValues) {
+    receiveMessages<cs::SpscChannel<Message>>();
+    receiveMessages<cs::MpmcChannel<Message>>();
+}
+
+TEST(Channel, RecvFor) {
+    cs::SpscChannel<int> channel(4);
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(channel.recvFor(std::chrono::milliseconds(10)).has_value());
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+
+    std::thread sender([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        channel.send(42);
+    });
+
+    auto value = channel.recvFor(std::chrono::seconds(5));
+    sender.join();
+
+    ASSERT_TRUE(value.has_value());
+    ASSERT_EQ(*value, 42);
+}
+
+TEST(Channel, BlockedSenderIsReleasedByClose) {
+    cs::MpscChannel<int> channel(2);
+
+    ASSERT_TRUE(channel.send(1));
+    ASSERT_TRUE(channel.send(2));
+
+    std::atomic<bool> result = { true };
+    std::atomic<bool> finished = { false };
+
+    std::thread sender([&] {
+        result = channel.send(3);
+        finished = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_FALSE(finished);
+
+    channel.close();
+    sender.join();
+
+    ASSERT_FALSE(result);
+}
+
+TEST(Channel, BlockedSendersAreWokenByReceivedValues) {
+    constexpr int sendersCount = 4;
+
+    cs::MpmcChannel<int> channel(2);
+
+    ASSERT_TRUE(channel.send(0));
+    ASSERT_TRUE(channel.send(0));
+
+    std::atomic<int> sent = { 0 };
+    std::vector<std::thread> senders;
+
+    for (int i = 0; i < sendersCount; ++i) {
+        senders.emplace_back([&, i] {
+            ASSERT_TRUE(channel.send(i + 1));
+            ++sent;
+        });
+    }
+
+    // every received value lets one more blocked sender in
+    int sum = 0;
+    std::vector<int> values;
+
+    while (values.size() != sendersCount + 2) {
+        if (values.size() % 2 == 0) {
+            channel.recvMany(std::back_inserter(values), 2);
+        }
+        else if (auto value = channel.recvFor(std::chrono::seconds(2)); value) {
+            values.push_back(*value);
+        }
+    }
+
+    for (auto& sender : senders) {
+        sender.join();
+    }
+
+    for (auto value : values) {
+        sum += value;
+    }
+
+    ASSERT_EQ(sent.load(), sendersCount);
+    ASSERT_EQ(sum, sendersCount * (sendersCount + 1) / 2);
+    ASSERT_TRUE(channel.isEmpty());
+}
+
+TEST(Channel, ReadySignal) {
+    constexpr int valuesCount = 1000;
+
+    cs::MpscChannel<int> channel(valuesCount);
+    std::atomic<int> sum = { 0 };
+    std::atomic<int> received = { 0 };
+
+    // slot drains channel at sender thread
+    cs::Connector::connect(&channel.ready, [&] {
+        while (auto value = channel.tryRecv()) {
+            sum.fetch_add(*value, std::memory_order_relaxed);
+            received.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // arms signal
+    ASSERT_FALSE(channel.tryRecv().has_value());
+
+    std::thread sender([&] {
+        for (int i = 1; i <= valuesCount; ++i) {
+            channel.send(i);
+        }
+    });
+
+    sender.join();
+    cs::Waiter::wait([&] { return received.load() != valuesCount; }, 2000);
+
+    ASSERT_EQ(received.load(), valuesCount);
+    ASSERT_EQ(sum.load(), valuesCount * (valuesCount + 1) / 2);
+}
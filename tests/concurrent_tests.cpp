@@ -59,3 +59,160 @@ TEST(Concurrent, RunBaseUsageWithResultThreadPolicy) {
 TEST(Concurrent, RunBaseUsageWithResultThreadPoolPolicy) {
     concurrentBaseUsageWithResult(cs::RunPolicy::ThreadPool);
 }
+
+TEST(Concurrent, RunLateSubscription) {
+    std::atomic<int> value = { 0 };
+
+    auto watcher = cs::Concurrent::run(cs::RunPolicy::ThreadPool, [] {
+        return 42;
+    });
+
+    cs::Waiter::wait([&] { return watcher->state() != cs::WatcherState::Compeleted; }, 2000);
+    ASSERT_EQ(watcher->state(), cs::WatcherState::Compeleted);
+
+    cs::Connector::connect(&watcher->finished, [&](const int result) {
+        value = result;
+    });
+
+    cs::Waiter::wait([&] { return value.load() == 0; }, 2000);
+    ASSERT_EQ(value.load(), 42);
+}
+
+TEST(Concurrent, RunFailed) {
+    std::atomic<bool> failed = { false };
+    std::atomic<bool> finished = { false };
+
+    auto watcher = cs::Concurrent::run(cs::RunPolicy::ThreadPool, [](int value) {
+        if (value != 0) {
+            throw std::runtime_error("test failure");
+        }
+    }, 1);
+
+    cs::Connector::connect(&watcher->finished, [&] {
+        finished = true;
+    });
+
+    cs::Connector::connect(&watcher->failed, [&] {
+        failed = true;
+    });
+
+    cs::Waiter::wait([&] { return !failed; }, 2000);
+
+    ASSERT_TRUE(failed);
+    ASSERT_FALSE(finished);
+}
+
+TEST(Concurrent, RunManyWatchers) {
+    constexpr size_t watchersCount = 10000;
+    std::atomic<size_t> counter = { 0 };
+
+    for (size_t i = 0; i < watchersCount; ++i) {
+        auto watcher = cs::Concurrent::run(cs::RunPolicy::ThreadPool, [](size_t value) {
+            return value;
+        }, i);
+
+        cs::Connector::connect(&watcher->finished, [&](size_t) {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    cs::Waiter::wait([&] { return counter.load() != watchersCount; }, 5000);
+    ASSERT_EQ(counter.load(), watchersCount);
+}
+
+TEST(Concurrent, ExecutionsIntrospection) {
+    struct Result {
+        size_t value = 0;
+    };
+
+    constexpr size_t executionsCount = 8;
+    std::atomic<bool> release = { false };
+
+    for (size_t i = 0; i < executionsCount; ++i) {
+        cs::Concurrent::run(cs::RunPolicy::Thread, [&](size_t value) {
+            cs::Waiter::wait([&] { return !release; }, 5000);
+            return Result{value};
+        }, i);
+    }
+
+    ASSERT_EQ(cs::Concurrent::executionsCount<Result>(), executionsCount);
+    ASSERT_GE(cs::Concurrent::executionsCount(), executionsCount);
+
+    const auto info = cs::Concurrent::executionsInfo();
+    const auto iter = std::find_if(info.begin(), info.end(), [](const cs::ExecutionsInfo& element) {
+        return element.type == typeid(Result).name();
+    });
+
+    ASSERT_NE(iter, info.end());
+    ASSERT_EQ(iter->count, executionsCount);
+
+    release = true;
+
+    cs::Waiter::wait([&] { return cs::Concurrent::executionsCount<Result>() != 0; }, 2000);
+    ASSERT_EQ(cs::Concurrent::executionsCount<Result>(), 0u);
+}
+
+TEST(Concurrent, RunAfter) {
+    std::atomic<bool> called = { false };
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<std::chrono::steady_clock::duration::rep> elapsed = { 0 };
+
+    cs::Concurrent::runAfter(std::chrono::milliseconds(50), [&] {
+        elapsed = (std::chrono::steady_clock::now() - start).count();
+        called = true;
+    }, cs::RunPolicy::ThreadPool);
+
+    cs::Waiter::wait([&] { return !called; }, 2000);
+
+    ASSERT_TRUE(called);
+    ASSERT_GE(std::chrono::steady_clock::duration(elapsed.load()), std::chrono::milliseconds(50));
+}
+
+TEST(Concurrent, RunAfterCancel) {
+    std::atomic<bool> called = { false };
+
+    auto handle = cs::Concurrent::runAfter(std::chrono::milliseconds(50), [&] {
+        called = true;
+    });
+
+    ASSERT_TRUE(handle.isActive());
+    ASSERT_TRUE(handle.cancel());
+    ASSERT_FALSE(handle.isActive());
+    ASSERT_FALSE(handle.cancel());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(called);
+}
+
+TEST(Concurrent, RunAfterManyTimers) {
+    constexpr size_t timersCount = 10000;
+    std::atomic<size_t> counter = { 0 };
+
+    for (size_t i = 0; i < timersCount; ++i) {
+        cs::Concurrent::runAfter(std::chrono::milliseconds(i % 100), [&] {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        }, cs::RunPolicy::ThreadPool);
+    }
+
+    cs::Waiter::wait([&] { return counter.load() != timersCount; }, 5000);
+    ASSERT_EQ(counter.load(), timersCount);
+}
+
+TEST(Concurrent, RunEvery) {
+    std::atomic<size_t> counter = { 0 };
+
+    auto handle = cs::Concurrent::runEvery(std::chrono::milliseconds(10), [&] {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    cs::Waiter::wait([&] { return counter.load() < 3; }, 2000);
+    ASSERT_GE(counter.load(), 3u);
+
+    ASSERT_TRUE(handle.cancel());
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    const auto value = counter.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(counter.load(), value);
+}
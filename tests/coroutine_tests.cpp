@@ -0,0 +1,74 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <cs/concurrent/coroutine.hpp>
+
+#ifdef CS_COROUTINES_SUPPORTED
+
+#include <thread>
+#include <stdexcept>
+
+namespace {
+cs::CoTask<std::thread::id> switchThread(cs::ThreadPool& pool) {
+    co_await pool.schedule();
+    co_return std::this_thread::get_id();
+}
+
+cs::CoTask<int> add(cs::ThreadPool& pool, int lhs, int rhs) {
+    co_await pool.schedule();
+    co_return lhs + rhs;
+}
+
+cs::CoTask<int> sum(cs::ThreadPool& pool, int count) {
+    int result = 0;
+
+    for (int i = 0; i < count; ++i) {
+        result = co_await add(pool, result, i);
+    }
+
+    co_return result;
+}
+
+cs::CoTask<void> fail(cs::ThreadPool& pool) {
+    co_await pool.schedule();
+    throw std::runtime_error("coroutine failure");
+}
+
+cs::CoTask<int> awaitWatcher(int value) {
+    co_return co_await cs::Concurrent::run(cs::RunPolicy::ThreadPool, [](int value) {
+        return value * 2;
+    }, value);
+}
+
+cs::CoTask<void> awaitFailedWatcher() {
+    co_await cs::Concurrent::run(cs::RunPolicy::ThreadPool, [] {
+        throw std::runtime_error("watcher failure");
+    });
+}
+}
+
+TEST(Coroutine, ScheduleResumesAtPool) {
+    cs::ThreadPool pool(2);
+    ASSERT_NE(switchThread(pool).get(), std::this_thread::get_id());
+}
+
+TEST(Coroutine, NestedTasks) {
+    cs::ThreadPool pool(4);
+    ASSERT_EQ(sum(pool, 100).get(), 4950);
+}
+
+TEST(Coroutine, TaskException) {
+    cs::ThreadPool pool(2);
+    ASSERT_THROW(fail(pool).get(), std::runtime_error);
+}
+
+TEST(Coroutine, AwaitWatcher) {
+    ASSERT_EQ(awaitWatcher(21).get(), 42);
+}
+
+TEST(Coroutine, AwaitFailedWatcher) {
+    ASSERT_THROW(awaitFailedWatcher().get(), std::runtime_error);
+}
+
+#endif // CS_COROUTINES_SUPPORTED
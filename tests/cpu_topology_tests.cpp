@@ -0,0 +1,91 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+
+#include <cs/concurrent/cpu_topology.hpp>
+
+namespace {
+// writes file of fake sysfs tree
+void write(const std::filesystem::path& path, const std::string& content) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path) << content << "\n";
+}
+}
+
+TEST(CpuTopology, ParseCpuList) {
+    ASSERT_EQ(cs::details::parseCpuList("0-3,8,10-11"), (std::vector<unsigned>{ 0, 1, 2, 3, 8, 10, 11 }));
+    ASSERT_EQ(cs::details::parseCpuList("5"), (std::vector<unsigned>{ 5 }));
+    ASSERT_TRUE(cs::details::parseCpuList("").empty());
+}
+
+#ifdef __linux__
+TEST(CpuTopology, ReadSysfs) {
+    const auto root = std::filesystem::temp_directory_path() / "cs_cpu_topology_test";
+    std::filesystem::remove_all(root);
+
+    // two packages with own l3 and numa node, processors 0, 1 at first one
+    write(root / "cpu" / "online", "0-3");
+    write(root / "node" / "online", "0-1");
+    write(root / "node" / "node0" / "cpulist", "0-1");
+    write(root / "node" / "node1" / "cpulist", "2-3");
+
+    for (unsigned cpu = 0; cpu < 4; ++cpu) {
+        const auto path = root / "cpu" / ("cpu" + std::to_string(cpu));
+        const auto package = cpu / 2;
+
+        write(path / "topology" / "physical_package_id", std::to_string(package));
+        write(path / "cache" / "index0" / "level", "1");
+        write(path / "cache" / "index0" / "shared_cpu_list", std::to_string(cpu));
+        write(path / "cache" / "index1" / "level", "3");
+        write(path / "cache" / "index1" / "shared_cpu_list", package == 0 ? "0-1" : "2-3");
+    }
+
+    const auto topology = cs::CpuTopology::read(root.string());
+    const auto restricted = cs::CpuTopology::read(root.string(), { 1, 2, 3, 5 });
+    std::filesystem::remove_all(root);
+
+    ASSERT_EQ(topology.cpus().size(), 4u);
+    ASSERT_EQ(topology.domainsCount(), 2u);
+
+    ASSERT_EQ(topology.domain(0), (std::vector<unsigned>{ 0, 1 }));
+    ASSERT_EQ(topology.domain(1), (std::vector<unsigned>{ 2, 3 }));
+    ASSERT_EQ(topology.domainOf(3), 1u);
+    ASSERT_EQ(topology.cpus()[2].node, 1u);
+    ASSERT_EQ(topology.cpus()[2].package, 1u);
+
+    // consecutive workers land at different domains
+    ASSERT_EQ(topology.spread(), (std::vector<unsigned>{ 0, 2, 1, 3 }));
+
+    // processors out of affinity mask are dropped, unknown allowed ones are ignored
+    ASSERT_EQ(restricted.cpus().size(), 3u);
+    ASSERT_EQ(restricted.domainsCount(), 2u);
+    ASSERT_EQ(restricted.domain(0), (std::vector<unsigned>{ 1 }));
+    ASSERT_EQ(restricted.domain(1), (std::vector<unsigned>{ 2, 3 }));
+    ASSERT_EQ(restricted.spread(), (std::vector<unsigned>{ 1, 2, 3 }));
+}
+
+TEST(CpuTopology, InstanceRespectsAffinity) {
+    const auto allowed = cs::details::allowedCpus();
+    const auto& cpus = cs::CpuTopology::instance().cpus();
+
+    ASSERT_FALSE(allowed.empty());
+    ASSERT_FALSE(cpus.empty());
+
+    for (const auto& cpu : cpus) {
+        ASSERT_TRUE(std::binary_search(allowed.begin(), allowed.end(), cpu.id));
+    }
+}
+
+TEST(CpuTopology, MissingSysfs) {
+    const auto topology = cs::CpuTopology::read("/nonexistent");
+
+    ASSERT_FALSE(topology.cpus().empty());
+    ASSERT_EQ(topology.domainsCount(), 1u);
+}
+#endif
@@ -0,0 +1,154 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/signals/signals.hpp>
+#include <cs/concurrent/event_loop.hpp>
+
+TEST(EventLoop, PostRunsInOrderAtLoopThread) {
+    constexpr size_t tasksCount = 1000;
+
+    cs::EventLoopThread thread;
+    std::vector<size_t> values;
+    std::atomic<bool> wrongThread = { false };
+    std::atomic<bool> done = { false };
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        thread.loop().post([&, i] {
+            if (std::this_thread::get_id() != thread.id() || !thread.loop().isCurrent()) {
+                wrongThread = true;
+            }
+
+            values.push_back(i);
+
+            if (values.size() == tasksCount) {
+                done = true;
+            }
+        });
+    }
+
+    cs::Waiter::wait([&] { return !done; }, 2000);
+
+    ASSERT_TRUE(done);
+    ASSERT_FALSE(wrongThread);
+    ASSERT_FALSE(thread.loop().isCurrent());
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        ASSERT_EQ(values[i], i);
+    }
+}
+
+TEST(EventLoop, PostDelayedOrder) {
+    cs::EventLoopThread thread;
+    std::vector<int> values;
+    std::atomic<bool> done = { false };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    thread.loop().postDelayed(std::chrono::milliseconds(30), [&] {
+        values.push_back(3);
+        done = true;
+    });
+
+    thread.loop().postDelayed(std::chrono::milliseconds(10), [&] {
+        values.push_back(1);
+    });
+
+    thread.loop().postDelayed(std::chrono::milliseconds(10), [&] {
+        values.push_back(2);
+    });
+
+    thread.loop().post([&] {
+        values.push_back(0);
+    });
+
+    cs::Waiter::wait([&] { return !done; }, 2000);
+
+    ASSERT_TRUE(done);
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+    ASSERT_EQ(values, std::vector<int>({ 0, 1, 2, 3 }));
+}
+
+TEST(EventLoop, ProcessEventsWithoutExec) {
+    cs::EventLoop loop;
+    size_t calls = 0;
+
+    loop.post([&] {
+        ++calls;
+
+        // nested post waits for next processing
+        loop.post([&] {
+            ++calls;
+        });
+    });
+
+    ASSERT_EQ(loop.processEvents(), 1u);
+    ASSERT_EQ(calls, 1u);
+
+    ASSERT_EQ(loop.processEvents(), 1u);
+    ASSERT_EQ(calls, 2u);
+
+    ASSERT_EQ(loop.processEvents(), 0u);
+    ASSERT_EQ(cs::EventLoop::current(), nullptr);
+}
+
+TEST(EventLoop, QuitOfJustStartedThread) {
+    constexpr size_t threadsCount = 2000;
+
+    // destruction quits loop at any point of its first iteration
+    for (size_t i = 0; i < threadsCount; ++i) {
+        cs::EventLoopThread thread;
+    }
+}
+
+TEST(EventLoop, QuitFromTask) {
+    cs::EventLoop loop;
+    bool called = false;
+
+    loop.postDelayed(std::chrono::milliseconds(10), [&] {
+        called = true;
+        loop.quit();
+    });
+
+    loop.exec();
+    ASSERT_TRUE(called);
+}
+
+TEST(EventLoop, WrapDeliversSignalAtLoopThread) {
+    constexpr int emitsCount = 1000;
+
+    cs::Signal<void(int)> signal;
+    cs::EventLoopThread thread;
+
+    int sum = 0;
+    std::atomic<bool> done = { false };
+    std::atomic<bool> wrongThread = { false };
+
+    cs::Connector::connect(&signal, thread.loop().wrap([&](int value) {
+        if (std::this_thread::get_id() != thread.id()) {
+            wrongThread = true;
+        }
+
+        sum += value;
+
+        if (value == emitsCount) {
+            done = true;
+        }
+    }));
+
+    for (int i = 1; i <= emitsCount; ++i) {
+        emit signal(i);
+    }
+
+    cs::Waiter::wait([&] { return !done; }, 2000);
+
+    ASSERT_TRUE(done);
+    ASSERT_FALSE(wrongThread);
+    ASSERT_EQ(sum, emitsCount * (emitsCount + 1) / 2);
+}
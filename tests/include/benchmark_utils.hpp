@@ -0,0 +1,56 @@
+#ifndef CS_BENCHMARK_UTILS_HPP
+#define CS_BENCHMARK_UTILS_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <cs/logger/logger.hpp>
+
+namespace cs::testing {
+using BenchmarkDuration = std::chrono::duration<double, std::milli>;
+
+// returns count of heap allocations made by benchmark process, see allocation_counter.cpp
+size_t allocationsCount() noexcept;
+
+// returns wall time of functor call
+template <typename Func>
+inline BenchmarkDuration measure(Func&& func) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::steady_clock::now() - start;
+}
+
+// prints operations count, time and throughput of benchmark case
+inline void report(const std::string& name, size_t operations, const BenchmarkDuration& duration) {
+    const auto throughput = duration.count() > 0 ? static_cast<double>(operations) / duration.count() * 1000.0 : 0.0;
+    cslog() << name << ": " << operations << " ops, " << duration.count() << " ms, " << static_cast<size_t>(throughput) << " ops/s";
+}
+
+// prints average latency of one operation
+inline void reportLatency(const std::string& name, size_t operations, const BenchmarkDuration& duration) {
+    const auto latency = operations != 0 ? duration.count() * 1'000'000.0 / static_cast<double>(operations) : 0.0;
+    cslog() << name << ": " << operations << " ops, " << duration.count() << " ms, " << latency << " ns/op";
+}
+
+// returns percentile of samples, samples are sorted in place
+inline double percentile(std::vector<double>& samples, double rank) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    const auto index = static_cast<size_t>(rank * static_cast<double>(samples.size() - 1));
+    return samples[index];
+}
+
+// prints p50, p99 and maximal latency of samples in microseconds
+inline void reportPercentiles(const std::string& name, std::vector<double>& samples) {
+    cslog() << name << ": " << samples.size() << " samples, p50 " << percentile(samples, 0.5) << " us, p99 "
+            << percentile(samples, 0.99) << " us, max " << percentile(samples, 1.0) << " us";
+}
+}
+
+#endif // CS_BENCHMARK_UTILS_HPP
@@ -0,0 +1,177 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+
+#include <destructor_counter.hpp>
+
+#include <cs/containers/mpmc_queue.hpp>
+
+using namespace cs::testing;
+
+namespace {
+// copy and move assignment throw on demand, move construction never throws
+struct Throwing {
+    explicit Throwing(int value, bool fails = false):
+        value(value), fails(fails) {}
+
+    Throwing(const Throwing& other):
+        value(other.value), fails(other.fails) {
+        if (fails) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+
+    Throwing(Throwing&&) noexcept = default;
+
+    Throwing& operator=(Throwing&& other) {
+        if (other.fails) {
+            throw std::runtime_error("assignment failed");
+        }
+
+        value = other.value;
+        return *this;
+    }
+
+    int value;
+    bool fails;
+};
+}
+
+TEST(MpmcQueue, CapacityIsPowerOfTwo) {
+    cs::MpmcQueue<int> queue(100);
+
+    ASSERT_EQ(queue.capacity(), 128);
+    ASSERT_TRUE(queue.isEmpty());
+}
+
+TEST(MpmcQueue, PushAndPop) {
+    cs::MpmcQueue<int> queue(4);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPush(i));
+    }
+
+    ASSERT_TRUE(queue.isFull());
+    ASSERT_FALSE(queue.tryPush(4));
+
+    for (int i = 0; i < 4; ++i) {
+        int value = -1;
+
+        ASSERT_TRUE(queue.tryPop(value));
+        ASSERT_EQ(value, i);
+    }
+
+    int value = -1;
+    ASSERT_FALSE(queue.tryPop(value));
+}
+
+TEST(MpmcQueue, FailedPushKeepsValue) {
+    cs::MpmcQueue<std::unique_ptr<int>> queue(2);
+
+    ASSERT_TRUE(queue.tryPush(std::make_unique<int>(1)));
+    ASSERT_TRUE(queue.tryPush(std::make_unique<int>(2)));
+
+    auto value = std::make_unique<int>(3);
+
+    ASSERT_FALSE(queue.tryPush(std::move(value)));
+    ASSERT_NE(value, nullptr);
+}
+
+TEST(MpmcQueue, DestroysRemainingValues) {
+    auto count = 0;
+
+    {
+        cs::MpmcQueue<std::shared_ptr<DestructorCounter>> queue(8);
+
+        queue.tryPush(std::make_shared<DestructorCounter>(count));
+        queue.tryPush(std::make_shared<DestructorCounter>(count));
+    }
+
+    ASSERT_EQ(count, 2);
+}
+
+TEST(MpmcQueue, MultipleProducersAndConsumers) {
+    constexpr size_t threadsCount = 4;
+    constexpr size_t valuesCount = 100000;
+
+    cs::MpmcQueue<size_t> queue(1024);
+    std::atomic<size_t> sum = { 0 };
+    std::atomic<size_t> popped = { 0 };
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < threadsCount; ++i) {
+        threads.emplace_back([&, i] {
+            for (size_t value = i; value < valuesCount; value += threadsCount) {
+                while (!queue.tryPush(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        threads.emplace_back([&] {
+            while (popped.load(std::memory_order_relaxed) < valuesCount) {
+                size_t value = 0;
+
+                if (queue.tryPop(value)) {
+                    sum.fetch_add(value, std::memory_order_relaxed);
+                    popped.fetch_add(1, std::memory_order_relaxed);
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(popped.load(), valuesCount);
+    ASSERT_EQ(sum.load(), valuesCount * (valuesCount - 1) / 2);
+}
+
+TEST(MpmcQueue, ThrowingConstructionDoesNotClaimSlot) {
+    cs::MpmcQueue<Throwing> queue(2);
+    const Throwing failing(1, true);
+
+    ASSERT_THROW(queue.tryPush(failing), std::runtime_error);
+    ASSERT_TRUE(queue.isEmpty());
+
+    ASSERT_TRUE(queue.tryPush(Throwing(2)));
+    ASSERT_TRUE(queue.tryPush(Throwing(3)));
+    ASSERT_FALSE(queue.tryPush(Throwing(4)));
+
+    std::optional<Throwing> value;
+
+    ASSERT_TRUE(queue.tryPop(value));
+    ASSERT_EQ(value->value, 2);
+}
+
+TEST(MpmcQueue, ThrowingPopReleasesSlot) {
+    cs::MpmcQueue<Throwing> queue(2);
+
+    ASSERT_TRUE(queue.tryPush(Throwing(1, true)));
+    ASSERT_TRUE(queue.tryPush(Throwing(2)));
+
+    Throwing value(0);
+
+    // failed value is lost, but its slot is free for next push and pop
+    ASSERT_THROW(queue.tryPop(value), std::runtime_error);
+    ASSERT_TRUE(queue.tryPush(Throwing(3)));
+
+    ASSERT_TRUE(queue.tryPop(value));
+    ASSERT_EQ(value.value, 2);
+
+    ASSERT_TRUE(queue.tryPop(value));
+    ASSERT_EQ(value.value, 3);
+    ASSERT_TRUE(queue.isEmpty());
+}
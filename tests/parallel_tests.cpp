@@ -0,0 +1,120 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include <cs/concurrent/parallel.hpp>
+
+TEST(Parallel, ForVisitsEveryIndexOnce) {
+    constexpr int size = 10000;
+
+    cs::ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(size);
+
+    cs::parallelFor(pool, 0, size, 0, [&](int index) {
+        visits[static_cast<size_t>(index)].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    ASSERT_TRUE(std::all_of(visits.begin(), visits.end(), [](const auto& value) { return value.load() == 1; }));
+}
+
+TEST(Parallel, ForWithGrainAndOffset) {
+    std::vector<int> values(1000, 0);
+
+    cs::parallelFor(size_t(100), values.size(), 7, [&](size_t index) {
+        values[index] = 1;
+    });
+
+    ASSERT_EQ(std::accumulate(values.begin(), values.end(), 0), 900);
+}
+
+TEST(Parallel, ForRethrowsException) {
+    cs::ThreadPool pool(2);
+
+    auto call = [&] {
+        cs::parallelFor(pool, 0, 1000, 1, [](int index) {
+            if (index == 500) {
+                throw std::runtime_error("failed");
+            }
+        });
+    };
+
+    ASSERT_THROW(call(), std::runtime_error);
+}
+
+TEST(Parallel, NestedForAtPoolWorker) {
+    cs::ThreadPool pool(2);
+    std::atomic<int> counter = { 0 };
+
+    cs::parallelFor(pool, 0, 8, 1, [&](int) {
+        cs::parallelFor(pool, 0, 100, 1, [&](int) {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        });
+    });
+
+    ASSERT_EQ(counter.load(), 800);
+}
+
+TEST(Parallel, Transform) {
+    std::vector<int> values(10000);
+    std::vector<int> result(values.size());
+
+    std::iota(values.begin(), values.end(), 0);
+
+    auto end = cs::parallelTransform(values.begin(), values.end(), result.begin(), [](int value) {
+        return value * 2;
+    });
+
+    ASSERT_EQ(end, result.end());
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(result[i], values[i] * 2);
+    }
+}
+
+TEST(Parallel, Reduce) {
+    std::vector<long long> values(100000);
+    std::iota(values.begin(), values.end(), 1);
+
+    cs::ThreadPool pool(4);
+
+    ASSERT_EQ(cs::parallelReduce(pool, values.begin(), values.end(), 0LL), std::accumulate(values.begin(), values.end(), 0LL));
+    ASSERT_EQ(cs::parallelReduce(values.begin(), values.begin(), 42LL), 42LL);
+    ASSERT_EQ(cs::parallelReduce(values.begin(), values.end(), 0LL, [](long long lhs, long long rhs) { return std::max(lhs, rhs); }), 100000LL);
+}
+
+TEST(Parallel, Scan) {
+    std::vector<long long> values(12345);
+    std::vector<long long> result(values.size());
+    std::vector<long long> expected(values.size());
+
+    std::iota(values.begin(), values.end(), 1);
+    std::partial_sum(values.begin(), values.end(), expected.begin());
+
+    cs::ThreadPool pool(4);
+    cs::parallelScan(pool, values.begin(), values.end(), result.begin());
+
+    ASSERT_EQ(result, expected);
+}
+
+TEST(Parallel, Sort) {
+    std::vector<int> values(100000);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 1000);
+
+    std::generate(values.begin(), values.end(), [&] { return distribution(generator); });
+
+    auto expected = values;
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+
+    cs::ThreadPool pool(4);
+    cs::parallelSort(pool, values.begin(), values.end(), std::greater<>());
+
+    ASSERT_EQ(values, expected);
+}
@@ -0,0 +1,172 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+#include <cs/concurrent/pipeline.hpp>
+
+TEST(Pipeline, SerialStagesKeepOrder) {
+    constexpr size_t valuesCount = 10000;
+
+    cs::ThreadPool pool(4);
+    cs::Pipeline pipeline(16, pool);
+
+    size_t produced = 0;
+    std::vector<size_t> result;
+
+    pipeline.add<void, size_t>(cs::StageMode::Serial, [&](cs::FlowControl& flow) {
+        if (produced == valuesCount) {
+            flow.stop();
+        }
+
+        return produced++;
+    })
+    .add<size_t, std::string>(cs::StageMode::Parallel, [](size_t value) {
+        // later values are often finished earlier
+        if (value % 7 == 0) {
+            std::this_thread::yield();
+        }
+
+        return std::to_string(value * value);
+    })
+    .add<std::string, void>(cs::StageMode::Serial, [&](std::string value) {
+        result.push_back(std::stoul(value));
+    });
+
+    ASSERT_EQ(pipeline.size(), 3u);
+
+    // pipeline could be run again
+    for (size_t run = 0; run < 2; ++run) {
+        produced = 0;
+        result.clear();
+
+        pipeline.run();
+
+        ASSERT_EQ(result.size(), valuesCount);
+
+        for (size_t i = 0; i < valuesCount; ++i) {
+            ASSERT_EQ(result[i], i * i);
+        }
+    }
+}
+
+TEST(Pipeline, TokensLimit) {
+    constexpr size_t maxTokens = 4;
+    constexpr int valuesCount = 1000;
+
+    cs::ThreadPool pool(4);
+    cs::Pipeline pipeline(maxTokens, pool);
+
+    int produced = 0;
+    std::atomic<size_t> inFlight = { 0 };
+    std::atomic<size_t> maxInFlight = { 0 };
+    std::atomic<int> sum = { 0 };
+
+    pipeline.add<void, int>(cs::StageMode::Serial, [&](cs::FlowControl& flow) {
+        if (produced == valuesCount) {
+            flow.stop();
+            return 0;
+        }
+
+        const auto count = inFlight.fetch_add(1) + 1;
+        auto max = maxInFlight.load();
+
+        while (count > max && !maxInFlight.compare_exchange_weak(max, count)) {}
+
+        return ++produced;
+    })
+    .add<int, void>(cs::StageMode::Parallel, [&](int value) {
+        std::this_thread::yield();
+        sum.fetch_add(value);
+        inFlight.fetch_sub(1);
+    });
+
+    pipeline.run();
+
+    ASSERT_EQ(sum.load(), valuesCount * (valuesCount + 1) / 2);
+    ASSERT_LE(maxInFlight.load(), maxTokens);
+}
+
+TEST(Pipeline, Exception) {
+    cs::ThreadPool pool(2);
+    cs::Pipeline pipeline(8, pool);
+
+    int produced = 0;
+    std::atomic<int> consumed = { 0 };
+
+    pipeline.add<void, int>(cs::StageMode::Serial, [&](cs::FlowControl&) {
+        // never stops by itself
+        return produced++;
+    })
+    .add<int, int>(cs::StageMode::Parallel, [](int value) {
+        if (value == 100) {
+            throw std::runtime_error("stage failure");
+        }
+
+        return value;
+    })
+    .add<int, void>(cs::StageMode::Serial, [&](int value) {
+        ASSERT_LT(value, 100);
+        ++consumed;
+    });
+
+    ASSERT_THROW(pipeline.run(), std::runtime_error);
+    ASSERT_LE(consumed.load(), 100);
+}
+
+TEST(Pipeline, MoveOnlyValues) {
+    constexpr int valuesCount = 1000;
+
+    cs::ThreadPool pool(2);
+    cs::Pipeline pipeline(8, pool);
+
+    int produced = 0;
+    int sum = 0;
+
+    // values and stage functors could be move only
+    auto offset = std::make_unique<int>(1);
+
+    pipeline.add<void, std::unique_ptr<int>>(cs::StageMode::Serial, [&](cs::FlowControl& flow) {
+        if (produced == valuesCount) {
+            flow.stop();
+        }
+
+        return std::make_unique<int>(produced++);
+    })
+    .add<std::unique_ptr<int>, std::vector<std::unique_ptr<int>>>(cs::StageMode::Parallel, [offset = std::move(offset)](std::unique_ptr<int> value) {
+        *value += *offset;
+
+        std::vector<std::unique_ptr<int>> values;
+        values.push_back(std::move(value));
+
+        return values;
+    })
+    .add<std::vector<std::unique_ptr<int>>, void>(cs::StageMode::Serial, [&](std::vector<std::unique_ptr<int>> values) {
+        sum += *values.front();
+    });
+
+    pipeline.run();
+    ASSERT_EQ(sum, valuesCount * (valuesCount + 1) / 2);
+}
+
+TEST(Pipeline, StageTypes) {
+    cs::Pipeline pipeline(4);
+
+    ASSERT_THROW(pipeline.run(), std::logic_error);
+    ASSERT_THROW((pipeline.add<int, void>(cs::StageMode::Serial, [](int) {})), std::logic_error);
+    ASSERT_THROW((pipeline.add<void, int>(cs::StageMode::Parallel, [](cs::FlowControl&) { return 0; })), std::logic_error);
+
+    pipeline.add<void, int>(cs::StageMode::Serial, [](cs::FlowControl& flow) {
+        flow.stop();
+        return 0;
+    });
+
+    ASSERT_THROW((pipeline.add<std::string, void>(cs::StageMode::Parallel, [](std::string) {})), std::logic_error);
+    ASSERT_NO_THROW(pipeline.run());
+}
@@ -0,0 +1,89 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <memory>
+
+#include <destructor_counter.hpp>
+
+#include <cs/containers/spsc_queue.hpp>
+
+using namespace cs::testing;
+
+TEST(SpscQueue, PushAndPop) {
+    cs::SpscQueue<int> queue(3);
+
+    ASSERT_EQ(queue.capacity(), 4);
+    ASSERT_TRUE(queue.isEmpty());
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPush(i));
+    }
+
+    ASSERT_TRUE(queue.isFull());
+    ASSERT_FALSE(queue.tryPush(4));
+
+    for (int i = 0; i < 4; ++i) {
+        int value = -1;
+
+        ASSERT_TRUE(queue.tryPop(value));
+        ASSERT_EQ(value, i);
+    }
+
+    int value = -1;
+    ASSERT_FALSE(queue.tryPop(value));
+}
+
+TEST(SpscQueue, FailedPushKeepsValue) {
+    cs::SpscQueue<std::unique_ptr<int>> queue(2);
+
+    ASSERT_TRUE(queue.tryPush(std::make_unique<int>(1)));
+    ASSERT_TRUE(queue.tryPush(std::make_unique<int>(2)));
+
+    auto value = std::make_unique<int>(3);
+
+    ASSERT_FALSE(queue.tryPush(std::move(value)));
+    ASSERT_NE(value, nullptr);
+}
+
+TEST(SpscQueue, DestroysRemainingValues) {
+    auto count = 0;
+
+    {
+        cs::SpscQueue<std::shared_ptr<DestructorCounter>> queue(8);
+
+        queue.tryPush(std::make_shared<DestructorCounter>(count));
+        queue.tryPush(std::make_shared<DestructorCounter>(count));
+    }
+
+    ASSERT_EQ(count, 2);
+}
+
+TEST(SpscQueue, ProducerAndConsumer) {
+    constexpr size_t valuesCount = 100000;
+
+    cs::SpscQueue<size_t> queue(64);
+
+    std::thread producer([&] {
+        for (size_t value = 0; value < valuesCount; ++value) {
+            while (!queue.tryPush(value)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (size_t expected = 0; expected < valuesCount;) {
+        size_t value = 0;
+
+        if (queue.tryPop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+}
@@ -0,0 +1,154 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/signals/signals.hpp>
+#include <cs/concurrent/strand.hpp>
+#include <cs/concurrent/concurrent.hpp>
+
+TEST(Strand, SerialExecution) {
+    constexpr size_t producersCount = 4;
+    constexpr size_t tasksCount = 5000;
+
+    cs::ThreadPool pool(4);
+    cs::Strand strand(pool);
+
+    std::atomic<bool> running = { false };
+    std::atomic<bool> overlapped = { false };
+    std::atomic<size_t> executed = { 0 };
+
+    // not atomic, strand serializes access
+    std::vector<size_t> last(producersCount, 0);
+    bool ordered = true;
+
+    std::vector<std::thread> producers;
+
+    for (size_t producer = 0; producer < producersCount; ++producer) {
+        producers.emplace_back([&, producer] {
+            for (size_t i = 1; i <= tasksCount; ++i) {
+                strand.post([&, producer, i] {
+                    if (running.exchange(true)) {
+                        overlapped = true;
+                    }
+
+                    ordered = ordered && (last[producer] + 1 == i);
+                    last[producer] = i;
+
+                    running = false;
+                    executed.fetch_add(1, std::memory_order_release);
+                });
+            }
+        });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    cs::Waiter::wait([&] { return executed.load(std::memory_order_acquire) != producersCount * tasksCount; }, 10000);
+
+    ASSERT_EQ(executed.load(), producersCount * tasksCount);
+    ASSERT_FALSE(overlapped);
+    ASSERT_TRUE(ordered);
+    ASSERT_EQ(strand.size(), 0u);
+}
+
+TEST(Strand, IsCurrent) {
+    cs::ThreadPool pool(2);
+    cs::Strand strand(pool);
+    cs::Strand other(pool);
+
+    std::atomic<int> result = { 0 };
+
+    strand.post([&] {
+        result = strand.isCurrent() && !other.isCurrent() ? 1 : 2;
+    });
+
+    cs::Waiter::wait([&] { return result.load() == 0; }, 2000);
+
+    ASSERT_EQ(result.load(), 1);
+    ASSERT_FALSE(strand.isCurrent());
+}
+
+TEST(Strand, ExceptionDoesNotStopStrand) {
+    cs::ThreadPool pool(2);
+    cs::Strand strand(pool);
+    std::atomic<bool> called = { false };
+
+    strand.post([] {
+        throw std::runtime_error("strand task failure");
+    });
+
+    strand.post([&] {
+        called = true;
+    });
+
+    cs::Waiter::wait([&] { return !called.load(); }, 2000);
+    ASSERT_TRUE(called);
+}
+
+TEST(Strand, ConcurrentExecute) {
+    constexpr size_t tasksCount = 1000;
+
+    cs::Strand strand;
+    std::vector<size_t> values;
+    std::atomic<bool> done = { false };
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        cs::Concurrent::execute(strand, [&, i] {
+            values.push_back(i);
+
+            if (values.size() == tasksCount) {
+                done = true;
+            }
+        });
+    }
+
+    cs::Waiter::wait([&] { return !done.load(); }, 5000);
+
+    ASSERT_TRUE(done);
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        ASSERT_EQ(values[i], i);
+    }
+}
+
+TEST(Strand, SignalDelivery) {
+    constexpr int emitsCount = 1000;
+
+    cs::ThreadPool pool(4);
+    cs::Strand strand(pool);
+    cs::Signal<void(int)> signal;
+
+    int sum = 0;
+    int calls = 0;
+    std::atomic<bool> done = { false };
+
+    cs::Connector::connect(&signal, strand.wrap([&, counter = 0](int value) mutable {
+        sum += value;
+        calls = ++counter;
+
+        if (calls == emitsCount) {
+            done = true;
+        }
+    }));
+
+    std::thread emitter([&] {
+        for (int i = 1; i <= emitsCount; ++i) {
+            emit signal(i);
+        }
+    });
+
+    emitter.join();
+    cs::Waiter::wait([&] { return !done.load(); }, 5000);
+
+    ASSERT_TRUE(done);
+    ASSERT_EQ(calls, emitsCount);
+    ASSERT_EQ(sum, emitsCount * (emitsCount + 1) / 2);
+}
@@ -0,0 +1,232 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/concurrent/event.hpp>
+#include <cs/concurrent/latch.hpp>
+#include <cs/concurrent/barrier.hpp>
+#include <cs/concurrent/semaphore.hpp>
+
+TEST(Futex, WaitTimeout) {
+    cs::details::FutexWord word = { 0 };
+
+    const auto start = std::chrono::steady_clock::now();
+    cs::details::futexWait(word, 0, std::chrono::milliseconds(20));
+
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+}
+
+TEST(Futex, WaitChangedValue) {
+    cs::details::FutexWord word = { 1 };
+
+    // value differs from expected, so thread does not sleep
+    ASSERT_TRUE(cs::details::futexWait(word, 0, std::chrono::seconds(10)));
+}
+
+TEST(Event, SetWakesAllWaiters) {
+    constexpr size_t threadsCount = 4;
+
+    cs::Event event;
+    std::atomic<size_t> woken = { 0 };
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < threadsCount; ++i) {
+        threads.emplace_back([&] {
+            event.wait();
+            woken.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(woken.load(), 0u);
+
+    event.set();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(woken.load(), threadsCount);
+    ASSERT_TRUE(event.isSet());
+}
+
+TEST(Event, ResetAndTimeout) {
+    cs::Event event(true);
+
+    ASSERT_TRUE(event.waitFor(std::chrono::milliseconds(0)));
+
+    event.reset();
+
+    ASSERT_FALSE(event.isSet());
+    ASSERT_FALSE(event.waitFor(std::chrono::milliseconds(20)));
+
+    std::thread setter([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        event.set();
+    });
+
+    ASSERT_TRUE(event.waitFor(std::chrono::seconds(10)));
+    setter.join();
+}
+
+TEST(Semaphore, BoundsConcurrency) {
+    constexpr size_t threadsCount = 8;
+    constexpr size_t iterations = 2000;
+    constexpr uint32_t permits = 2;
+
+    cs::Semaphore semaphore(permits);
+    std::atomic<uint32_t> inside = { 0 };
+    std::atomic<bool> exceeded = { false };
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < threadsCount; ++i) {
+        threads.emplace_back([&] {
+            for (size_t j = 0; j < iterations; ++j) {
+                semaphore.acquire();
+
+                if (inside.fetch_add(1) + 1 > permits) {
+                    exceeded = true;
+                }
+
+                inside.fetch_sub(1);
+                semaphore.release();
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_FALSE(exceeded);
+    ASSERT_EQ(semaphore.available(), permits);
+}
+
+TEST(Semaphore, TryAcquire) {
+    cs::Semaphore semaphore(1);
+
+    ASSERT_TRUE(semaphore.tryAcquire());
+    ASSERT_FALSE(semaphore.tryAcquire());
+    ASSERT_FALSE(semaphore.tryAcquireFor(std::chrono::milliseconds(20)));
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        semaphore.release(3);
+    });
+
+    ASSERT_TRUE(semaphore.tryAcquireFor(std::chrono::seconds(10)));
+    releaser.join();
+
+    ASSERT_EQ(semaphore.available(), 2u);
+}
+
+TEST(Latch, CountDown) {
+    constexpr uint32_t threadsCount = 4;
+
+    cs::Latch latch(threadsCount);
+    std::atomic<uint32_t> done = { 0 };
+    std::vector<std::thread> threads;
+
+    for (uint32_t i = 0; i < threadsCount; ++i) {
+        threads.emplace_back([&] {
+            done.fetch_add(1, std::memory_order_relaxed);
+            latch.countDown();
+        });
+    }
+
+    latch.wait();
+
+    ASSERT_TRUE(latch.tryWait());
+    ASSERT_EQ(done.load(), threadsCount);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(Latch, Timeout) {
+    cs::Latch latch(2);
+
+    latch.countDown();
+
+    ASSERT_FALSE(latch.tryWait());
+    ASSERT_FALSE(latch.waitFor(std::chrono::milliseconds(20)));
+
+    latch.arriveAndWait();
+
+    ASSERT_TRUE(latch.waitFor(std::chrono::milliseconds(0)));
+}
+
+TEST(Barrier, Phases) {
+    constexpr uint32_t threadsCount = 4;
+    constexpr uint32_t phasesCount = 100;
+
+    std::atomic<uint32_t> arrived = { 0 };
+    std::atomic<bool> broken = { false };
+    uint32_t completions = 0;
+
+    cs::Barrier barrier(threadsCount, [&] {
+        // completion runs while all threads are blocked at barrier
+        if (arrived.exchange(0) != threadsCount) {
+            broken = true;
+        }
+
+        ++completions;
+    });
+
+    std::vector<std::thread> threads;
+
+    for (uint32_t i = 0; i < threadsCount; ++i) {
+        threads.emplace_back([&] {
+            for (uint32_t phase = 0; phase < phasesCount; ++phase) {
+                arrived.fetch_add(1);
+
+                if (barrier.arriveAndWait() != phase) {
+                    broken = true;
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_FALSE(broken);
+    ASSERT_EQ(completions, phasesCount);
+    ASSERT_EQ(barrier.phase(), phasesCount);
+}
+
+TEST(Waiter, NotifierWakesWaiter) {
+    cs::Notifier notifier;
+    std::atomic<bool> ready = { false };
+
+    std::thread notifying([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        ready.store(true, std::memory_order_release);
+        notifier.notify();
+    });
+
+    const bool result = cs::Waiter::wait(notifier, [&] { return !ready.load(std::memory_order_acquire); }, 10000);
+    notifying.join();
+
+    ASSERT_TRUE(result);
+    ASSERT_TRUE(ready.load());
+}
+
+TEST(Waiter, NotifierTimeout) {
+    cs::Notifier notifier;
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool result = cs::Waiter::wait(notifier, [] { return true; }, 20);
+
+    ASSERT_FALSE(result);
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
@@ -0,0 +1,135 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+
+#include <cs/concurrent/task_graph.hpp>
+
+TEST(TaskGraph, DiamondOrder) {
+    cs::ThreadPool pool(4);
+    cs::TaskGraph graph(pool);
+
+    std::mutex mutex;
+    std::vector<char> order;
+
+    auto record = [&](char name) {
+        return [&, name] {
+            std::lock_guard lock(mutex);
+            order.push_back(name);
+        };
+    };
+
+    auto a = graph.add(record('a'), "a");
+    auto b = graph.add(record('b'), "b");
+    auto c = graph.add(record('c'), "c");
+    auto d = graph.add(record('d'), "d");
+
+    graph.precede(a, b);
+    graph.precede(a, c);
+    graph.precede(b, d);
+    graph.precede(c, d);
+
+    graph.run();
+
+    ASSERT_EQ(order.size(), 4u);
+    ASSERT_EQ(order.front(), 'a');
+    ASSERT_EQ(order.back(), 'd');
+}
+
+TEST(TaskGraph, RepeatedRuns) {
+    constexpr size_t runsCount = 100;
+    constexpr size_t layersCount = 5;
+    constexpr size_t layerSize = 8;
+
+    cs::ThreadPool pool(4, cs::SchedulePolicy::WorkStealing);
+    cs::TaskGraph graph(pool);
+    std::atomic<size_t> counter = { 0 };
+
+    std::vector<cs::TaskGraph::NodeId> previous;
+
+    for (size_t layer = 0; layer < layersCount; ++layer) {
+        std::vector<cs::TaskGraph::NodeId> current;
+
+        for (size_t i = 0; i < layerSize; ++i) {
+            const auto expected = layer * layerSize;
+
+            current.push_back(graph.add([&, expected] {
+                // all nodes of previous layers are finished
+                ASSERT_GE(counter.fetch_add(1, std::memory_order_acq_rel) % (layersCount * layerSize), expected);
+            }));
+
+            for (auto node : previous) {
+                graph.precede(node, current.back());
+            }
+        }
+
+        previous = std::move(current);
+    }
+
+    for (size_t i = 0; i < runsCount; ++i) {
+        graph.run();
+    }
+
+    ASSERT_EQ(counter.load(), runsCount * layersCount * layerSize);
+
+    for (const auto& node : graph.profile()) {
+        ASSERT_EQ(node.runs, runsCount);
+    }
+}
+
+TEST(TaskGraph, Exception) {
+    cs::ThreadPool pool(2);
+    cs::TaskGraph graph(pool);
+    std::atomic<bool> called = { false };
+
+    auto first = graph.add([] {
+        throw std::runtime_error("node failure");
+    });
+
+    auto second = graph.add([&] {
+        called = true;
+    });
+
+    graph.precede(first, second);
+
+    ASSERT_THROW(graph.run(), std::runtime_error);
+    ASSERT_FALSE(called);
+}
+
+TEST(TaskGraph, Cycle) {
+    cs::TaskGraph graph;
+
+    auto first = graph.add([] {});
+    auto second = graph.add([] {});
+
+    graph.precede(first, second);
+    graph.precede(second, first);
+
+    ASSERT_THROW(graph.run(), std::logic_error);
+    ASSERT_THROW(graph.precede(first, 10), std::out_of_range);
+}
+
+TEST(TaskGraph, Profile) {
+    cs::ThreadPool pool(2);
+    cs::TaskGraph graph(pool);
+
+    auto first = graph.add([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }, "first");
+
+    auto second = graph.add([] {}, "second");
+    graph.precede(first, second);
+
+    graph.run();
+
+    const auto profile = graph.profile();
+
+    ASSERT_EQ(profile.size(), 2u);
+    ASSERT_EQ(profile[0].name, "first");
+    ASSERT_GE(profile[0].duration, std::chrono::milliseconds(2));
+    ASSERT_GE(profile[1].start, profile[0].start + profile[0].duration);
+}
@@ -0,0 +1,120 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include <cs/concurrent/task_group.hpp>
+
+namespace {
+size_t fibonacci(cs::ThreadPool& pool, size_t value) {
+    if (value < 2) {
+        return value;
+    }
+
+    size_t lhs = 0;
+    size_t rhs = 0;
+
+    cs::TaskGroup group(pool);
+
+    group.run([&] {
+        lhs = fibonacci(pool, value - 1);
+    });
+
+    rhs = fibonacci(pool, value - 2);
+    group.wait();
+
+    return lhs + rhs;
+}
+}
+
+TEST(TaskGroup, BaseUsage) {
+    constexpr size_t tasksCount = 1000;
+
+    std::atomic<size_t> counter = { 0 };
+    cs::ThreadPool pool(4);
+    cs::TaskGroup group(pool);
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        group.run([&] {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    group.wait();
+
+    ASSERT_EQ(counter.load(), tasksCount);
+    ASSERT_EQ(group.size(), 0u);
+}
+
+TEST(TaskGroup, WaitWithoutChildren) {
+    cs::TaskGroup group;
+    group.wait();
+
+    ASSERT_EQ(group.size(), 0u);
+}
+
+TEST(TaskGroup, ExceptionPropagation) {
+    cs::ThreadPool pool(2);
+    cs::TaskGroup group(pool);
+
+    for (size_t i = 0; i < 100; ++i) {
+        group.run([i] {
+            if (i == 10) {
+                throw std::runtime_error("child failure");
+            }
+        });
+    }
+
+    ASSERT_THROW(group.wait(), std::runtime_error);
+    ASSERT_TRUE(group.isCancelled());
+
+    // exception is rethrown once
+    group.wait();
+}
+
+TEST(TaskGroup, Cancellation) {
+    std::atomic<bool> release = { false };
+    std::atomic<size_t> counter = { 0 };
+
+    cs::ThreadPool pool(1);
+    cs::TaskGroup group(pool);
+
+    // blocks single worker until children are queued
+    group.run([&] {
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+
+    for (size_t i = 0; i < 100; ++i) {
+        group.run([&] {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    group.cancel();
+    release = true;
+
+    group.wait();
+    ASSERT_EQ(counter.load(), 0u);
+}
+
+TEST(TaskGroup, NestedGroupsDoNotStarvePool) {
+    cs::ThreadPool pool(2);
+    ASSERT_EQ(fibonacci(pool, 20), 6765u);
+
+    cs::ThreadPool singleWorkerPool(1, cs::SchedulePolicy::WorkStealing);
+    ASSERT_EQ(fibonacci(singleWorkerPool, 18), 2584u);
+}
+
+TEST(TaskGroup, WaitFromPoolWorker) {
+    cs::ThreadPool pool(1);
+
+    auto future = pool.enqueueFuture([&] {
+        return fibonacci(pool, 15);
+    });
+
+    ASSERT_EQ(future.get(), 610u);
+}
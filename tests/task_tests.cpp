@@ -0,0 +1,117 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <future>
+
+#include <destructor_counter.hpp>
+
+#include <cs/concurrent/task.hpp>
+
+using namespace cs::testing;
+
+TEST(Task, DefaultConstruct) {
+    cs::Task task;
+
+    ASSERT_FALSE(task);
+    ASSERT_FALSE(task.isInline());
+    ASSERT_THROW(task(), std::bad_function_call);
+}
+
+TEST(Task, SmallLambdaIsInline) {
+    auto called = 0;
+    cs::Task task([&called] {
+        ++called;
+    });
+
+    ASSERT_TRUE(task);
+    ASSERT_TRUE(task.isInline());
+
+    task();
+    task();
+
+    ASSERT_EQ(called, 2);
+}
+
+TEST(Task, LargeLambdaUsesHeap) {
+    std::array<char, cs::Task::inlineSize * 2> buffer = {};
+    buffer.back() = 1;
+
+    auto result = 0;
+    cs::Task task([buffer, &result] {
+        result = buffer.back();
+    });
+
+    ASSERT_FALSE(task.isInline());
+
+    task();
+    ASSERT_EQ(result, 1);
+}
+
+TEST(Task, MoveOnlyFunctor) {
+    auto value = std::make_unique<int>(42);
+    auto result = 0;
+
+    cs::Task task([value = std::move(value), &result] {
+        result = *value;
+    });
+
+    cs::Task other = std::move(task);
+
+    ASSERT_FALSE(task);
+    ASSERT_TRUE(other);
+
+    other();
+    ASSERT_EQ(result, 42);
+}
+
+TEST(Task, PackagedTaskIsInline) {
+    std::packaged_task<int()> packagedTask([] {
+        return 42;
+    });
+
+    auto future = packagedTask.get_future();
+    cs::Task task(std::move(packagedTask));
+
+    ASSERT_TRUE(task.isInline());
+
+    task();
+    ASSERT_EQ(future.get(), 42);
+}
+
+TEST(Task, DestroysFunctor) {
+    auto inlineCount = 0;
+    auto heapCount = 0;
+
+    {
+        auto counter = std::make_shared<DestructorCounter>(inlineCount);
+        cs::Task task([counter] {});
+    }
+
+    {
+        std::array<char, cs::Task::inlineSize * 2> buffer = {};
+        auto counter = std::make_shared<DestructorCounter>(heapCount);
+
+        cs::Task task([counter, buffer] {});
+        cs::Task other = std::move(task);
+        other.reset();
+
+        ASSERT_FALSE(other);
+    }
+
+    ASSERT_EQ(inlineCount, 1);
+    ASSERT_EQ(heapCount, 1);
+}
+
+TEST(Task, FunctionPointer) {
+    static auto called = false;
+
+    cs::Task task(+[] {
+        called = true;
+    });
+
+    task();
+    ASSERT_TRUE(called);
+}
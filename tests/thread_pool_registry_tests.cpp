@@ -0,0 +1,96 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/concurrent/concurrent.hpp>
+#include <cs/concurrent/thread_pool_registry.hpp>
+
+TEST(ThreadPoolRegistry, NamedPools) {
+    auto& registry = cs::ThreadPoolRegistry::instance();
+
+    ASSERT_TRUE(registry.contains(cs::computePool));
+    ASSERT_TRUE(registry.contains(cs::blockingPool));
+    ASSERT_FALSE(registry.contains("registry_test_unknown"));
+    ASSERT_THROW(registry.get("registry_test_unknown"), std::out_of_range);
+
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 2;
+    options.idle = cs::IdlePolicy::SpinThenPark;
+
+    registry.configure("registry_test_pool", options, cs::TaskPriority::High);
+
+    auto& pool = registry.get("registry_test_pool");
+
+    ASSERT_EQ(&pool, &registry.get("registry_test_pool"));
+    ASSERT_EQ(pool.size(), 2u);
+    ASSERT_EQ(pool.options().idle, cs::IdlePolicy::SpinThenPark);
+    ASSERT_EQ(registry.priority("registry_test_pool"), cs::TaskPriority::High);
+
+    // running pool could not be reconfigured
+    ASSERT_THROW(registry.configure("registry_test_pool", options), std::logic_error);
+
+    std::promise<cs::ThreadPool*> promise;
+    registry.enqueue("registry_test_pool", [&] {
+        promise.set_value(cs::ThreadPool::current());
+    });
+
+    ASSERT_EQ(promise.get_future().get(), &pool);
+}
+
+TEST(ThreadPoolRegistry, ExternalPool) {
+    auto& registry = cs::ThreadPoolRegistry::instance();
+    cs::ThreadPool pool(1);
+
+    registry.add("registry_test_external", pool);
+
+    ASSERT_EQ(&registry.get("registry_test_external"), &pool);
+    ASSERT_THROW(registry.add("registry_test_external", pool), std::logic_error);
+}
+
+TEST(ThreadPoolRegistry, RunPolicies) {
+    auto& registry = cs::ThreadPoolRegistry::instance();
+
+    ASSERT_EQ(&registry.compute(), &cs::ThreadPool::instance());
+
+    auto runAt = [](cs::RunPolicy policy) {
+        std::atomic<cs::ThreadPool*> pool = { nullptr };
+        std::atomic<bool> finished = { false };
+
+        cs::Concurrent::execute(policy, [&] {
+            pool = cs::ThreadPool::current();
+            finished = true;
+        });
+
+        cs::Waiter::wait([&] { return !finished.load(); }, 2000);
+        return pool.load();
+    };
+
+    ASSERT_EQ(runAt(cs::RunPolicy::Compute), &registry.compute());
+    ASSERT_EQ(runAt(cs::RunPolicy::Blocking), &registry.blocking());
+    ASSERT_NE(&registry.compute(), &registry.blocking());
+}
+
+TEST(ThreadPoolRegistry, NestedTaskOfWaitingTask) {
+    // every waiting task of thread cache and blocking pool gets own thread for its nested task
+    for (auto policy : { cs::RunPolicy::Thread, cs::RunPolicy::Blocking }) {
+        std::promise<bool> result;
+
+        cs::Concurrent::execute(policy, [&result, policy] {
+            std::promise<void> nested;
+            auto future = nested.get_future();
+
+            cs::Concurrent::execute(policy, [&nested] {
+                nested.set_value();
+            });
+
+            result.set_value(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        });
+
+        ASSERT_TRUE(result.get_future().get());
+    }
+}
@@ -2,6 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <mutex>
+#include <vector>
+#include <future>
+#include <thread>
+#include <functional>
+
 #include <cs/utils/waiter.hpp>
 #include <cs/concurrent/thread_pool.hpp>
 
@@ -30,3 +36,661 @@ TEST(ThreadPool, BaseUsageFuture) {
 
     ASSERT_TRUE(called.load(std::memory_order_acquire));
 }
+
+TEST(ThreadPool, WorkStealingBaseUsage) {
+    static std::atomic<bool> called = { false };
+
+    cs::ThreadPool pool(4, cs::SchedulePolicy::WorkStealing);
+    pool.enqueue([] {
+        called.store(true, std::memory_order_release);
+    });
+
+    cs::Waiter::wait([] { return !called.load(std::memory_order_acquire); }, 2000);
+
+    ASSERT_TRUE(called.load(std::memory_order_acquire));
+    ASSERT_EQ(pool.policy(), cs::SchedulePolicy::WorkStealing);
+}
+
+TEST(ThreadPool, WorkStealingFuture) {
+    cs::ThreadPool pool(4, cs::SchedulePolicy::WorkStealing);
+    auto future = pool.enqueueFuture([](int value) {
+        return value * 2;
+    }, 21);
+
+    ASSERT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPool, WorkStealingNestedTasks) {
+    constexpr size_t tasksCount = 100;
+    constexpr size_t childrenCount = 10;
+
+    std::atomic<size_t> counter = { 0 };
+    cs::ThreadPool pool(4, cs::SchedulePolicy::WorkStealing);
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        pool.enqueue([&] {
+            for (size_t j = 0; j < childrenCount; ++j) {
+                pool.enqueue([&] {
+                    counter.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+        });
+    }
+
+    cs::Waiter::wait([&] { return counter.load(std::memory_order_acquire) != tasksCount * childrenCount; }, 5000);
+    ASSERT_EQ(counter.load(std::memory_order_acquire), tasksCount * childrenCount);
+}
+
+TEST(ThreadPool, LockFreeBaseUsage) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 4;
+    options.schedule = cs::SchedulePolicy::LockFree;
+    options.capacity = 16;
+
+    cs::ThreadPool pool(options);
+    auto future = pool.enqueueFuture([](int value) {
+        return value * 2;
+    }, 21);
+
+    ASSERT_EQ(future.get(), 42);
+    ASSERT_EQ(pool.policy(), cs::SchedulePolicy::LockFree);
+}
+
+TEST(ThreadPool, LockFreeBlockingOverflow) {
+    constexpr size_t tasksCount = 10000;
+
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 2;
+    options.schedule = cs::SchedulePolicy::LockFree;
+    options.capacity = 8;
+    options.overflow = cs::OverflowPolicy::Block;
+
+    std::atomic<size_t> counter = { 0 };
+    cs::ThreadPool pool(options);
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        pool.enqueue([&] {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    cs::Waiter::wait([&] { return counter.load(std::memory_order_acquire) != tasksCount; }, 5000);
+    ASSERT_EQ(counter.load(std::memory_order_acquire), tasksCount);
+}
+
+TEST(ThreadPool, LockFreeFailingOverflow) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 1;
+    options.schedule = cs::SchedulePolicy::LockFree;
+    options.capacity = 2;
+    options.overflow = cs::OverflowPolicy::Fail;
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    cs::ThreadPool pool(options);
+    auto blocker = pool.enqueueFuture([released] {
+        released.wait();
+    });
+
+    bool full = false;
+
+    for (size_t i = 0; i < 8 && !full; ++i) {
+        full = !pool.tryEnqueue([released] { released.wait(); });
+    }
+
+    ASSERT_TRUE(full);
+    ASSERT_THROW(pool.enqueue([] {}), std::runtime_error);
+
+    release.set_value();
+    blocker.get();
+}
+
+static void bulkEnqueue(cs::SchedulePolicy policy) {
+    constexpr size_t tasksCount = 1000;
+
+    std::atomic<size_t> counter = { 0 };
+    std::vector<std::function<void()>> tasks(tasksCount, [&] {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    cs::ThreadPool pool(4, policy);
+    pool.enqueueBulk(tasks.begin(), tasks.end());
+
+    cs::Waiter::wait([&] { return counter.load(std::memory_order_acquire) != tasksCount; }, 5000);
+    ASSERT_EQ(counter.load(std::memory_order_acquire), tasksCount);
+}
+
+TEST(ThreadPool, EnqueueBulk) {
+    bulkEnqueue(cs::SchedulePolicy::SharedQueue);
+    bulkEnqueue(cs::SchedulePolicy::WorkStealing);
+    bulkEnqueue(cs::SchedulePolicy::LockFree);
+}
+
+TEST(ThreadPool, EnqueueBulkFuture) {
+    constexpr int tasksCount = 100;
+
+    std::vector<std::function<int()>> tasks;
+
+    for (int i = 0; i < tasksCount; ++i) {
+        tasks.push_back([i] {
+            return i * i;
+        });
+    }
+
+    cs::ThreadPool pool(4);
+    auto futures = pool.enqueueBulkFuture(tasks.begin(), tasks.end());
+
+    ASSERT_EQ(futures.size(), static_cast<size_t>(tasksCount));
+
+    for (int i = 0; i < tasksCount; ++i) {
+        ASSERT_EQ(futures[static_cast<size_t>(i)].get(), i * i);
+    }
+}
+
+static void idlePolicyUsage(const cs::ThreadPoolOptions& options) {
+    constexpr size_t tasksCount = 100;
+    std::atomic<size_t> counter = { 0 };
+
+    cs::ThreadPool pool(options);
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        pool.enqueue([&] {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        // let workers go idle between tasks
+        if (i % 10 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    cs::Waiter::wait([&] { return counter.load(std::memory_order_acquire) != tasksCount; }, 5000);
+    ASSERT_EQ(counter.load(std::memory_order_acquire), tasksCount);
+}
+
+TEST(ThreadPool, SpinThenParkIdlePolicy) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 4;
+    options.idle = cs::IdlePolicy::SpinThenPark;
+
+    idlePolicyUsage(options);
+
+    options.schedule = cs::SchedulePolicy::WorkStealing;
+    idlePolicyUsage(options);
+
+    options.schedule = cs::SchedulePolicy::LockFree;
+    idlePolicyUsage(options);
+}
+
+TEST(ThreadPool, HotWorkers) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 2;
+    options.hotWorkers = 1;
+    options.spinCount = 64;
+    options.yieldCount = 4;
+
+    idlePolicyUsage(options);
+}
+
+TEST(ThreadPool, ElasticGrowAndRetire) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 1;
+    options.maxThreadsCount = 4;
+    options.idleTimeout = std::chrono::milliseconds(50);
+
+    cs::ThreadPool pool(options);
+
+    ASSERT_EQ(pool.size(), 1u);
+    ASSERT_EQ(pool.capacity(), 4u);
+
+    std::atomic<bool> release = { false };
+    std::atomic<size_t> started = { 0 };
+
+    for (size_t i = 0; i < pool.capacity(); ++i) {
+        pool.enqueue([&] {
+            started.fetch_add(1, std::memory_order_relaxed);
+            cs::Waiter::wait([&] { return !release; }, 5000);
+        });
+    }
+
+    // every blocked task gets own worker
+    cs::Waiter::wait([&] { return started.load() != pool.capacity(); }, 2000);
+    ASSERT_EQ(started.load(), pool.capacity());
+    ASSERT_EQ(pool.size(), pool.capacity());
+
+    release = true;
+
+    cs::Waiter::wait([&] { return pool.size() != options.threadsCount; }, 2000);
+    ASSERT_EQ(pool.size(), options.threadsCount);
+
+    // retired slots are reused
+    auto future = pool.enqueueFuture([] {
+        return 42;
+    });
+
+    ASSERT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPool, ElasticPoolWithoutPermanentWorkers) {
+    constexpr size_t tasksCount = 1000;
+
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 0;
+    options.maxThreadsCount = 8;
+    options.idleTimeout = std::chrono::milliseconds(10);
+
+    std::atomic<size_t> counter = { 0 };
+    cs::ThreadPool pool(options);
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        pool.enqueue([&] {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        if (i % 100 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(15));
+        }
+    }
+
+    cs::Waiter::wait([&] { return counter.load(std::memory_order_acquire) != tasksCount; }, 5000);
+
+    ASSERT_EQ(counter.load(std::memory_order_acquire), tasksCount);
+    ASSERT_LE(pool.size(), options.maxThreadsCount);
+}
+
+TEST(ThreadPool, Stats) {
+    constexpr size_t tasksCount = 100;
+
+    cs::ThreadPool pool(2, cs::SchedulePolicy::WorkStealing);
+    std::vector<std::function<void()>> tasks(tasksCount, [] {
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+    });
+
+    auto futures = pool.enqueueBulkFuture(tasks.begin(), tasks.end());
+
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    const auto stats = pool.stats();
+
+    ASSERT_EQ(stats.workersCount, 2u);
+    ASSERT_EQ(stats.queueDepth, 0u);
+
+#ifdef CS_THREAD_POOL_METRICS
+    ASSERT_TRUE(stats.enabled);
+    ASSERT_EQ(stats.workers.size(), 2u);
+
+    // last task counters are updated after its future is ready
+    cs::Waiter::wait([&] { return pool.stats().executionTime.count() != tasksCount; }, 2000);
+
+    const auto finished = pool.stats();
+    uint64_t executed = 0;
+
+    for (const auto& worker : finished.workers) {
+        executed += worker.tasks;
+    }
+
+    ASSERT_EQ(executed, tasksCount);
+    ASSERT_EQ(finished.waitTime.count(), tasksCount);
+    ASSERT_GE(finished.executionTime.percentile(0.5), std::chrono::microseconds(8));
+#else
+    ASSERT_FALSE(stats.enabled);
+    ASSERT_TRUE(stats.workers.empty());
+#endif
+}
+
+// runs tasks added by enqueue functor at one worker after they are all queued, returns execution order
+template <typename Enqueue>
+static std::vector<int> prioritizedOrder(const cs::ThreadPoolOptions& options, Enqueue&& enqueue) {
+    cs::ThreadPool pool(options);
+
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+
+    pool.enqueue([&started, releaseFuture] {
+        started.set_value();
+        releaseFuture.wait();
+    });
+
+    started.get_future().wait();
+
+    std::mutex mutex;
+    std::vector<int> order;
+
+    const size_t count = enqueue(pool, [&](int value) {
+        return [&, value] {
+            std::lock_guard lock(mutex);
+            order.push_back(value);
+        };
+    });
+
+    release.set_value();
+
+    cs::Waiter::wait([&] {
+        std::lock_guard lock(mutex);
+        return order.size() != count;
+    }, 5000);
+
+    std::lock_guard lock(mutex);
+    return order;
+}
+
+static cs::ThreadPoolOptions singleWorker(cs::SchedulePolicy policy, size_t starvationLimit = 16) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 1;
+    options.schedule = policy;
+    options.starvationLimit = starvationLimit;
+
+    return options;
+}
+
+static cs::ThreadPoolOptions nextSlotWorkers(cs::ThreadPoolOptions options) {
+    options.nextTaskSlot = true;
+    return options;
+}
+
+TEST(ThreadPool, PriorityLanes) {
+    for (auto policy : { cs::SchedulePolicy::SharedQueue, cs::SchedulePolicy::WorkStealing, cs::SchedulePolicy::LockFree }) {
+        auto order = prioritizedOrder(singleWorker(policy), [](cs::ThreadPool& pool, auto record) {
+            const auto now = std::chrono::steady_clock::now();
+
+            pool.enqueue(cs::TaskPriority::Low, record(5));
+            pool.enqueue(record(4));
+            pool.enqueue(now + std::chrono::hours(1), record(3));
+            pool.enqueue(cs::TaskPriority::High, record(2));
+            pool.enqueue(now - std::chrono::seconds(1), record(1));
+            pool.enqueue(cs::TaskPriority::Normal, record(4));
+
+            return size_t(6);
+        });
+
+        ASSERT_EQ(order, std::vector<int>({ 1, 2, 3, 4, 4, 5 }));
+    }
+}
+
+TEST(ThreadPool, PriorityStarvationProtection) {
+    constexpr size_t limit = 4;
+    constexpr int tasksCount = 100;
+
+    // normal task is taken after limit high tasks
+    auto order = prioritizedOrder(singleWorker(cs::SchedulePolicy::SharedQueue, limit), [](cs::ThreadPool& pool, auto record) {
+        for (int i = 0; i < tasksCount; ++i) {
+            pool.enqueue(cs::TaskPriority::High, record(0));
+        }
+
+        pool.enqueue(record(1));
+        return size_t(tasksCount + 1);
+    });
+
+    ASSERT_EQ(order.size(), size_t(tasksCount + 1));
+    ASSERT_EQ(order[limit], 1);
+
+    // low task is taken after limit tasks of other lanes
+    order = prioritizedOrder(singleWorker(cs::SchedulePolicy::WorkStealing, limit), [](cs::ThreadPool& pool, auto record) {
+        pool.enqueue(cs::TaskPriority::Low, record(1));
+
+        for (int i = 0; i < tasksCount; ++i) {
+            pool.enqueue(i % 2 ? cs::TaskPriority::High : cs::TaskPriority::Normal, record(0));
+        }
+
+        return size_t(tasksCount + 1);
+    });
+
+    ASSERT_EQ(order.size(), size_t(tasksCount + 1));
+    ASSERT_EQ(order[limit], 1);
+}
+
+TEST(ThreadPool, NextTaskSlot) {
+    for (auto policy : { cs::SchedulePolicy::SharedQueue, cs::SchedulePolicy::WorkStealing, cs::SchedulePolicy::LockFree }) {
+        auto order = prioritizedOrder(nextSlotWorkers(singleWorker(policy)), [](cs::ThreadPool& pool, auto record) {
+            pool.enqueue([&pool, record] {
+                record(1)();
+
+                // last follow up runs next, others go to queue
+                pool.enqueue(record(3));
+                pool.enqueue(record(3));
+                pool.enqueue(record(2));
+            });
+
+            pool.enqueue(record(3));
+            return size_t(5);
+        });
+
+        ASSERT_EQ(order.size(), 5u);
+        ASSERT_EQ(order[0], 1);
+        ASSERT_EQ(order[1], 2);
+    }
+}
+
+TEST(ThreadPool, NextTaskSlotStarvationProtection) {
+    constexpr size_t limit = 4;
+    constexpr int stepsCount = 100;
+
+    // chain of follow ups lets queued task go after limit slot tasks
+    std::function<void(int)> step;
+
+    auto order = prioritizedOrder(nextSlotWorkers(singleWorker(cs::SchedulePolicy::SharedQueue, limit)), [&step](cs::ThreadPool& pool, auto record) {
+        step = [&pool, &step, record](int index) {
+            record(0)();
+
+            if (index < stepsCount) {
+                pool.enqueue([&step, index] {
+                    step(index + 1);
+                });
+            }
+        };
+
+        pool.enqueue([&step] {
+            step(0);
+        });
+
+        pool.enqueue(record(1));
+        return size_t(stepsCount + 2);
+    });
+
+    ASSERT_EQ(order.size(), size_t(stepsCount + 2));
+    ASSERT_EQ(order[limit + 1], 1);
+}
+
+TEST(ThreadPool, NextTaskSlotOfBlockedWorker) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 2;
+
+    cs::ThreadPool pool(nextSlotWorkers(options));
+
+    std::atomic<bool> ran = { false };
+    std::promise<bool> result;
+
+    // follow up is taken from slot by other worker while its owner waits for it
+    pool.enqueue([&] {
+        pool.enqueue([&] {
+            ran = true;
+        });
+
+        cs::Waiter::wait([&] { return !ran.load(); }, 5000);
+        result.set_value(ran.load());
+    });
+
+    ASSERT_TRUE(result.get_future().get());
+}
+
+TEST(ThreadPool, NextTaskSlotOfBlockedWorkerWithHotWorkers) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 2;
+    options.hotWorkers = 2;
+
+    cs::ThreadPool pool(nextSlotWorkers(options));
+
+    std::atomic<bool> ran = { false };
+    std::promise<bool> result;
+
+    // hot workers never park, so spinning one should notice full slot of blocked owner
+    pool.enqueue([&] {
+        pool.enqueue([&] {
+            ran = true;
+        });
+
+        cs::Waiter::wait([&] { return !ran.load(); }, 5000);
+        result.set_value(ran.load());
+    });
+
+    ASSERT_TRUE(result.get_future().get());
+}
+
+TEST(ThreadPool, NextTaskSlotOfBlockedWorkerAtBusyPool) {
+    constexpr size_t tasksCount = 2000;
+
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 2;
+
+    cs::ThreadPool pool(nextSlotWorkers(options));
+
+    std::atomic<bool> ran = { false };
+    std::atomic<size_t> done = { 0 };
+    std::atomic<size_t> doneBeforeFollowUp = { 0 };
+    std::promise<void> started;
+    std::promise<void> finished;
+
+    // owner blocks on its follow up, other worker takes aged slot task before queued ones
+    pool.enqueue([&] {
+        pool.enqueue([&] {
+            doneBeforeFollowUp = done.load();
+            ran = true;
+        });
+
+        started.set_value();
+        cs::Waiter::wait([&] { return !ran.load(); }, 10000);
+    });
+
+    started.get_future().wait();
+
+    for (size_t i = 0; i < tasksCount; ++i) {
+        pool.enqueue([&] {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+
+            if (done.fetch_add(1) + 1 == tasksCount) {
+                finished.set_value();
+            }
+        });
+    }
+
+    finished.get_future().wait();
+
+    ASSERT_TRUE(ran);
+    ASSERT_LT(doneBeforeFollowUp.load(), tasksCount / 2);
+}
+
+TEST(ThreadPool, NextTaskSlotOfElasticPool) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 0;
+    options.maxThreadsCount = 4;
+
+    cs::ThreadPool pool(nextSlotWorkers(options));
+    std::promise<bool> result;
+
+    // nested task starts new worker while its owner waits for it
+    pool.enqueue([&] {
+        std::atomic<bool> ran = { false };
+
+        pool.enqueue([&] {
+            ran = true;
+        });
+
+        cs::Waiter::wait([&] { return !ran.load(); }, 5000);
+        result.set_value(ran.load());
+    });
+
+    ASSERT_TRUE(result.get_future().get());
+    ASSERT_EQ(pool.size(), 2u);
+}
+
+TEST(ThreadPool, BlockingRegionCompensation) {
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 1;
+    options.compensationLimit = 1;
+
+    cs::ThreadPool pool(options);
+
+    std::atomic<bool> released = { false };
+    std::atomic<bool> finished = { false };
+
+    // single worker waits for task queued after it, only compensation worker could run that task
+    pool.enqueue([&] {
+        cs::BlockingRegion region;
+        cs::Waiter::wait([&] { return !released.load(); }, 5000);
+        finished = true;
+    });
+
+    pool.enqueue([&] {
+        released = true;
+    });
+
+    cs::Waiter::wait([&] { return !finished.load(); }, 5000);
+
+    ASSERT_TRUE(released.load());
+    ASSERT_TRUE(finished.load());
+
+    // compensation worker exits after region ends
+    cs::Waiter::wait([&] { return pool.size() != 1; }, 2000);
+    ASSERT_EQ(pool.size(), 1u);
+
+    // region outside of pool does nothing
+    ASSERT_EQ(cs::blocking([] { return 42; }), 42);
+    ASSERT_EQ(cs::ThreadPool::current(), nullptr);
+}
+
+#ifdef __linux__
+TEST(ThreadPool, WorkerAffinity) {
+    // returns processors allowed to every worker which ran one of tasks
+    auto allowed = [](const cs::ThreadPoolOptions& options) {
+        cs::ThreadPool pool(options);
+
+        std::mutex mutex;
+        std::vector<size_t> counts;
+
+        auto futures = std::vector<std::future<void>>();
+
+        for (size_t i = 0; i < 16; ++i) {
+            futures.push_back(pool.enqueueFuture([&] {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+
+                std::lock_guard lock(mutex);
+                counts.push_back(static_cast<size_t>(CPU_COUNT(&set)));
+
+                // processor 0 is pinned by both cases
+                ASSERT_TRUE(CPU_ISSET(0, &set));
+            }));
+        }
+
+        for (auto& future : futures) {
+            future.get();
+        }
+
+        return counts;
+    };
+
+    cs::ThreadPoolOptions options;
+    options.threadsCount = 2;
+    options.schedule = cs::SchedulePolicy::WorkStealing;
+    options.affinity = cs::AffinityPolicy::Explicit;
+    options.cpuSets = { { 0 } };
+
+    for (auto count : allowed(options)) {
+        ASSERT_EQ(count, 1u);
+    }
+
+    // single processor system spreads all workers to the same processor
+    if (cs::CpuTopology::instance().cpus().size() == 1) {
+        options.affinity = cs::AffinityPolicy::Topology;
+
+        for (auto count : allowed(options)) {
+            ASSERT_EQ(count, 1u);
+        }
+    }
+}
+#endif
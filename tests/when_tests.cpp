@@ -0,0 +1,190 @@
+#define TESTING
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+#include <cs/utils/waiter.hpp>
+#include <cs/concurrent/when.hpp>
+#include <cs/concurrent/concurrent.hpp>
+
+TEST(When, ThenChain) {
+    std::atomic<int> value = { 0 };
+
+    auto watcher = cs::Concurrent::run(cs::RunPolicy::ThreadPool, [] {
+        return 20;
+    })->then([](int result) {
+        return result * 2;
+    })->then([](int result) {
+        return std::to_string(result + 2);
+    });
+
+    cs::Connector::connect(&watcher->finished, [&](const std::string& result) {
+        value = std::stoi(result);
+    });
+
+    cs::Waiter::wait([&] { return value.load() == 0; }, 2000);
+    ASSERT_EQ(value.load(), 42);
+}
+
+TEST(When, ThenOfCompletedWatcher) {
+    std::atomic<bool> called = { false };
+
+    auto watcher = cs::Concurrent::run(cs::RunPolicy::ThreadPool, [] {});
+
+    cs::Waiter::wait([&] { return watcher->state() != cs::WatcherState::Compeleted; }, 2000);
+    ASSERT_EQ(watcher->state(), cs::WatcherState::Compeleted);
+
+    auto next = watcher->then([&] {
+        called = true;
+    }, cs::RunPolicy::Thread);
+
+    cs::Waiter::wait([&] { return next->state() != cs::WatcherState::Compeleted; }, 2000);
+    ASSERT_TRUE(called);
+}
+
+TEST(When, ThenPassesFailure) {
+    std::atomic<bool> called = { false };
+    std::atomic<bool> failed = { false };
+
+    auto watcher = cs::Concurrent::run(cs::RunPolicy::ThreadPool, []() -> int {
+        throw std::runtime_error("test failure");
+    })->then([&](int) {
+        called = true;
+    });
+
+    cs::Connector::connect(&watcher->failed, [&] {
+        failed = true;
+    });
+
+    cs::Waiter::wait([&] { return !failed; }, 2000);
+
+    ASSERT_TRUE(failed);
+    ASSERT_FALSE(called);
+}
+
+TEST(When, AllOfVector) {
+    constexpr size_t watchersCount = 16;
+
+    std::vector<cs::FutureWatcherPtr<size_t>> watchers;
+    std::atomic<bool> finished = { false };
+    std::vector<size_t> values;
+
+    for (size_t i = 0; i < watchersCount; ++i) {
+        watchers.push_back(cs::Concurrent::run(cs::RunPolicy::ThreadPool, [](size_t value) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(value % 3));
+            return value * value;
+        }, i));
+    }
+
+    auto all = cs::whenAll(watchers);
+
+    cs::Connector::connect(&all->finished, [&](const std::vector<size_t>& results) {
+        values = results;
+        finished = true;
+    });
+
+    cs::Waiter::wait([&] { return !finished; }, 2000);
+    ASSERT_TRUE(finished);
+    ASSERT_EQ(values.size(), watchersCount);
+
+    for (size_t i = 0; i < watchersCount; ++i) {
+        ASSERT_EQ(values[i], i * i);
+    }
+}
+
+TEST(When, AllOfDifferentTypes) {
+    std::atomic<bool> finished = { false };
+
+    auto number = cs::Concurrent::run(cs::RunPolicy::ThreadPool, [] { return 1; });
+    auto text = cs::Concurrent::run(cs::RunPolicy::Thread, [] { return std::string("text"); });
+    auto nothing = cs::Concurrent::run(cs::RunPolicy::ThreadPool, [] {});
+
+    auto all = cs::whenAll(number, text, nothing);
+
+    cs::Connector::connect(&all->finished, [&](const std::tuple<int, std::string, std::monostate>& results) {
+        finished = std::get<0>(results) == 1 && std::get<1>(results) == "text";
+    });
+
+    cs::Waiter::wait([&] { return !finished; }, 2000);
+    ASSERT_TRUE(finished);
+}
+
+TEST(When, AllFailsByFirstFailure) {
+    std::atomic<bool> failed = { false };
+    std::atomic<bool> release = { false };
+
+    auto slow = cs::Concurrent::run(cs::RunPolicy::Thread, [&] {
+        cs::Waiter::wait([&] { return !release; }, 2000);
+    });
+
+    auto failing = cs::Concurrent::run(cs::RunPolicy::ThreadPool, [] {
+        throw std::runtime_error("test failure");
+    });
+
+    auto all = cs::whenAll(std::vector<cs::FutureWatcherPtr<void>>{ slow, failing });
+
+    cs::Connector::connect(&all->failed, [&] {
+        failed = true;
+    });
+
+    // failure does not wait for slow watcher
+    cs::Waiter::wait([&] { return !failed; }, 2000);
+    ASSERT_TRUE(failed);
+    ASSERT_NE(slow->state(), cs::WatcherState::Compeleted);
+
+    release = true;
+    cs::Waiter::wait([&] { return slow->state() != cs::WatcherState::Compeleted; }, 2000);
+}
+
+TEST(When, AllOfEmptyVector) {
+    auto all = cs::whenAll(std::vector<cs::FutureWatcherPtr<int>>{});
+    ASSERT_EQ(all->state(), cs::WatcherState::Compeleted);
+}
+
+TEST(When, AnyTakesFirstResult) {
+    std::atomic<size_t> index = { 0 };
+    std::atomic<int> value = { 0 };
+    std::atomic<bool> release = { false };
+
+    auto slow = cs::Concurrent::run(cs::RunPolicy::Thread, [&] {
+        cs::Waiter::wait([&] { return !release; }, 2000);
+        return 1;
+    });
+
+    auto fast = cs::Concurrent::run(cs::RunPolicy::ThreadPool, [] {
+        return 2;
+    });
+
+    auto any = cs::whenAny(slow, fast);
+
+    cs::Connector::connect(&any->finished, [&](const std::pair<size_t, int>& result) {
+        index = result.first;
+        value = result.second;
+    });
+
+    cs::Waiter::wait([&] { return value.load() == 0; }, 2000);
+
+    ASSERT_EQ(index.load(), 1u);
+    ASSERT_EQ(value.load(), 2);
+
+    release = true;
+    cs::Waiter::wait([&] { return slow->state() != cs::WatcherState::Compeleted; }, 2000);
+}
+
+TEST(When, AnyOfEmptyVectorFails) {
+    auto any = cs::whenAny(std::vector<cs::FutureWatcherPtr<void>>{});
+    std::atomic<bool> failed = { false };
+
+    cs::Connector::connect(&any->failed, [&] {
+        failed = true;
+    });
+
+    cs::Waiter::wait([&] { return !failed; }, 2000);
+    ASSERT_TRUE(failed);
+}